@@ -0,0 +1,31 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <chrono>
+#include <cstddef>
+#include <print>
+#include <string_view>
+
+namespace bench {
+
+    // results of every run are added here, so the compiler can't drop the measured work
+    inline volatile size_t sink = 0;
+
+    // calls fun once to warm up, then the given number of times, and prints the average time
+    // of each of the items a call processes. fun returns a value derived from its work, which goes to the sink
+    template<typename Function>
+    void run(std::string_view name, size_t iterations, size_t items, Function &&fun) {
+        sink = sink + static_cast<size_t>(fun());
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i=0; i<iterations; ++i) {
+            sink = sink + static_cast<size_t>(fun());
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+        std::println("{:<48} {:>12.1f} ns", name, elapsed.count() / (iterations * items));
+    }
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <vector>
+
+#include "bench.h"
+
+#include "game/game.h"
+#include "game/game_options.h"
+#include "cards/expansion_set.h"
+
+// size of the cards of a game and heap allocated by setting one up, with every expansion that can be enabled together.
+// only uses what game already had before card_data was shared, so it can be built at both commits to compare them
+
+using namespace banggame;
+
+static size_t allocated_bytes = 0;
+static size_t allocation_count = 0;
+
+void *operator new(size_t size) {
+    allocated_bytes += size;
+    ++allocation_count;
+    if (void *ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+static expansion_set largest_valid_expansions() {
+    expansion_set result;
+    for (const ruleset_vtable *ruleset : all_cards.expansions) {
+        expansion_set with_ruleset = result;
+        with_ruleset.insert(ruleset);
+        if (validate_expansions(with_ruleset)) {
+            result = std::move(with_ruleset);
+        }
+    }
+    return result;
+}
+
+int main() {
+    // game_table keeps a reference to its options, so they have to outlive the game
+    game_options options{
+        .expansions = largest_valid_expansions(),
+        .character_choice = false,
+        .game_seed = 1
+    };
+
+    std::vector<int> user_ids(lobby_max_players);
+    std::iota(user_ids.begin(), user_ids.end(), 1);
+
+    auto start_game = [&]{
+        game g{options};
+        g.add_players(user_ids);
+        g.start_game();
+        return rn::distance(g.get_all_cards());
+    };
+
+    size_t bytes_before = allocated_bytes;
+    size_t count_before = allocation_count;
+    size_t num_cards = start_game();
+
+    std::println("sizeof(card_data) = {}, sizeof(card) = {}", sizeof(card_data), sizeof(card));
+    std::println("{} cards, {} bytes in card objects", num_cards, num_cards * sizeof(card));
+    std::println("{} bytes in {} allocations to set up a game",
+        allocated_bytes - bytes_before, allocation_count - count_before);
+
+    bench::run("construct a game and start_game", 100, 1, start_game);
+}
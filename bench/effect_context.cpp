@@ -0,0 +1,75 @@
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+#include "bench.h"
+
+#include "cards/card_defs.h"
+
+// copies of effect_context, as done for every candidate in the playable cards search.
+// baseline_context only serves as a reference: it has the members of effect_context
+// as they were when the selections were kept in std::vector and std::unordered_map
+
+using namespace banggame;
+
+struct baseline_context : effect_context_base {
+    player_list selected_players;
+    card_list selected_cards;
+    std::unordered_map<const_card_ptr, std::pair<card_list, int>> selected_cubes;
+    nullable_player skipped_player;
+    nullable_card traincost;
+    nullable_card target_card;
+    int8_t discount;
+    bool disable_banglimit;
+    bool disable_bang_checks;
+    bool temp_missable;
+};
+
+// the pointers are only copied and compared, never dereferenced, so any distinct address will do
+alignas(std::max_align_t) static std::array<std::array<std::byte, 64>, 8> fake_objects;
+
+template<typename T>
+static T *fake_pointer(size_t index) {
+    return reinterpret_cast<T *>(fake_objects[index].data());
+}
+
+static void add_cubes(effect_context &ctx, card_ptr origin_card, size_t count) {
+    ctx.selected_cubes.insert(origin_card, card_list(count, origin_card), 1);
+}
+
+static void add_cubes(baseline_context &ctx, card_ptr origin_card, size_t count) {
+    ctx.selected_cubes.emplace(origin_card, std::pair{card_list(count, origin_card), 1});
+}
+
+template<typename Context>
+static void bench_copies(std::string_view name, const Context &ctx) {
+    bench::run(name, 1000000, 1, [&]{
+        Context copy = ctx;
+        return copy.selected_players.size() + copy.selected_cards.size();
+    });
+}
+
+template<typename Context>
+static void bench_context(std::string_view name) {
+    std::println("{}, time per copy:", name);
+
+    Context empty{};
+    bench_copies("  no selections", empty);
+
+    Context targets{};
+    targets.selected_players.push_back(fake_pointer<player>(0));
+    targets.selected_players.push_back(fake_pointer<player>(1));
+    targets.selected_cards.push_back(fake_pointer<card>(2));
+    bench_copies("  2 players and 1 card", targets);
+
+    Context cubes{};
+    add_cubes(cubes, fake_pointer<card>(3), 2);
+    add_cubes(cubes, fake_pointer<card>(4), 1);
+    bench_copies("  cubes from 2 cards", cubes);
+}
+
+int main() {
+    bench_context<effect_context>("effect_context");
+    bench_context<baseline_context>("baseline layout (reference)");
+}
@@ -0,0 +1,105 @@
+#include <functional>
+#include <limits>
+#include <map>
+#include <typeindex>
+#include <utility>
+
+#include "bench.h"
+
+#include "game/event_map.h"
+#include "game/game_events.h"
+
+// call_event throughput with the listeners of a game in progress: a few on the event that's called,
+// and many more spread between other event types
+
+using namespace banggame;
+
+template<int N>
+struct other_event {
+    int *value;
+};
+
+static constexpr int num_other_types = 40;
+static constexpr int listeners_per_other_type = 5;
+
+// the call path of the listener_map before the per-type buckets:
+// every listener in one multimap, ordered by event type then priority
+class multimap_listener_map {
+private:
+    using listener_key = std::pair<std::type_index, int>;
+    std::multimap<listener_key, std::move_only_function<void(const void *tuple)>> m_listeners;
+
+public:
+    template<event T, typename Function>
+    void add_listener(int priority, Function &&fun) {
+        m_listeners.emplace(listener_key{typeid(T), priority}, [fun=std::forward<Function>(fun)](const void *tuple) mutable {
+            std::apply(fun, *static_cast<const event_tuple<T> *>(tuple));
+        });
+    }
+
+    template<event T>
+    void call_event(const T &value) {
+        auto tuple = to_event_tuple(value);
+        auto low = m_listeners.lower_bound(listener_key{typeid(T), std::numeric_limits<int>::min()});
+        auto high = m_listeners.upper_bound(listener_key{typeid(T), std::numeric_limits<int>::max()});
+        for (auto it = low; it != high; ++it) {
+            it->second(&tuple);
+        }
+    }
+};
+
+static void range_listener(const_player_ptr origin, range_mod_type type, int &value) {
+    ++value;
+}
+
+static void other_listener(int *value) {
+    ++*value;
+}
+
+// adds listeners_per_other_type listeners on each of the other event types
+static void add_other_listeners(auto &&add_listener) {
+    [&]<int ... Ns>(std::integer_sequence<int, Ns ...>) {
+        for (int priority=0; priority<listeners_per_other_type; ++priority) {
+            (add_listener(std::in_place_type<other_event<Ns>>, priority), ...);
+        }
+    }(std::make_integer_sequence<int, num_other_types>());
+}
+
+static void fill_listeners(multimap_listener_map &map, int num_range_listeners) {
+    add_other_listeners([&]<typename T>(std::in_place_type_t<T>, int priority) {
+        map.add_listener<T>(priority, &other_listener);
+    });
+    for (int i=0; i<num_range_listeners; ++i) {
+        map.add_listener<event_type::count_range_mod>(i, &range_listener);
+    }
+}
+
+static void fill_listeners(listener_map &map, int num_range_listeners) {
+    add_other_listeners([&]<typename T>(std::in_place_type_t<T>, int priority) {
+        map.add_listener<T>(event_card_key{nullptr, priority}, &other_listener);
+    });
+    for (int i=0; i<num_range_listeners; ++i) {
+        map.add_listener<event_type::count_range_mod>(event_card_key{nullptr, i}, &range_listener);
+    }
+}
+
+static size_t call_range_mod(auto &map) {
+    int value = 0;
+    map.call_event(event_type::count_range_mod{ nullptr, range_mod_type::range_mod, value });
+    return value;
+}
+
+int main() {
+    for (int num_range_listeners : {0, 2, 8}) {
+        multimap_listener_map old_map;
+        fill_listeners(old_map, num_range_listeners);
+
+        listener_map new_map;
+        fill_listeners(new_map, num_range_listeners);
+
+        std::println("{} listeners on count_range_mod, {} on other events, time per call_event:",
+            num_range_listeners, num_other_types * listeners_per_other_type);
+        bench::run("  multimap", 1000000, 1, [&]{ return call_range_mod(old_map); });
+        bench::run("  per-type buckets", 1000000, 1, [&]{ return call_range_mod(new_map); });
+    }
+}
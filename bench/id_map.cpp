@@ -0,0 +1,64 @@
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench.h"
+
+#include "utils/id_map.h"
+
+// shuffle_cards_and_ids at the deck sizes of a game: the base deck, every main deck card, and every card
+
+struct bench_card {
+    size_t id;
+};
+
+using card_storage = utils::id_map<bench_card>;
+
+static std::vector<bench_card *> make_deck(card_storage &storage, size_t size) {
+    std::vector<bench_card *> result;
+    for (size_t i=1; i<=size; ++i) {
+        result.push_back(&storage.emplace(i));
+    }
+    return result;
+}
+
+// the shuffle before swap_slots: both values are extracted and inserted back with their new ids
+static size_t shuffle_extract_insert(card_storage &storage, std::span<bench_card *> vec, std::default_random_engine &rng) {
+    for (size_t i = vec.size() - 1; i > 0; --i) {
+        size_t i2 = std::uniform_int_distribution<size_t>{0, i}(rng);
+        if (i == i2) continue;
+
+        std::swap(vec[i], vec[i2]);
+        auto a = storage.extract(vec[i]->id);
+        auto b = storage.extract(vec[i2]->id);
+        std::swap(a->id, b->id);
+        storage.insert(std::move(a));
+        storage.insert(std::move(b));
+    }
+    return vec.front()->id;
+}
+
+static size_t shuffle_swap_slots(card_storage &storage, std::span<bench_card *> vec, std::default_random_engine &rng) {
+    for (size_t i = vec.size() - 1; i > 0; --i) {
+        size_t i2 = std::uniform_int_distribution<size_t>{0, i}(rng);
+        if (i == i2) continue;
+
+        std::swap(vec[i], vec[i2]);
+        std::swap(vec[i]->id, vec[i2]->id);
+        storage.swap_slots(*vec[i], *vec[i2]);
+    }
+    return vec.front()->id;
+}
+
+int main() {
+    std::default_random_engine rng;
+
+    for (size_t deck_size : {80, 228, 456}) {
+        card_storage storage;
+        auto deck = make_deck(storage, deck_size);
+
+        std::println("{} cards, time per shuffle:", deck_size);
+        bench::run("  extract and insert", 10000, 1, [&]{ return shuffle_extract_insert(storage, deck, rng); });
+        bench::run("  swap_slots", 10000, 1, [&]{ return shuffle_swap_slots(storage, deck, rng); });
+    }
+}
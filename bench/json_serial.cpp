@@ -0,0 +1,80 @@
+#include <numeric>
+#include <vector>
+
+#include "bench.h"
+
+#include "game/game.h"
+#include "game/game_options.h"
+#include "cards/expansion_set.h"
+
+// the two largest updates sent on every change of the game state, request_status and status_ready,
+// written straight as json text by string_writer, or built as a json tree and dumped like before
+
+using namespace banggame;
+
+static expansion_set largest_valid_expansions() {
+    expansion_set result;
+    for (const ruleset_vtable *ruleset : all_cards.expansions) {
+        expansion_set with_ruleset = result;
+        with_ruleset.insert(ruleset);
+        if (validate_expansions(with_ruleset)) {
+            result = std::move(with_ruleset);
+        }
+    }
+    return result;
+}
+
+static void bench_update(std::string_view name, game &g, const game_update &update) {
+    std::string text = g.write_update(update);
+    if (text != g.serialize_update_tree(update).dump(-1, ' ', true, json::json::error_handler_t::replace)) {
+        std::println("{}: string_writer and dump don't match", name);
+    }
+
+    std::println("{}, {} bytes, time per update:", name, text.size());
+    bench::run("  string_writer", 10000, 1, [&]{
+        return g.write_update(update).size();
+    });
+    bench::run("  serialize + dump", 10000, 1, [&]{
+        return g.serialize_update_tree(update).dump(-1, ' ', true, json::json::error_handler_t::replace).size();
+    });
+}
+
+int main() {
+    // game_table keeps a reference to its options, so they have to outlive the game
+    game_options options{
+        .expansions = largest_valid_expansions(),
+        .character_choice = false,
+        .game_seed = 1
+    };
+    game g{options};
+
+    std::vector<int> user_ids(lobby_max_players);
+    std::iota(user_ids.begin(), user_ids.end(), 1);
+    g.add_players(user_ids);
+    g.start_game();
+    g.commit_updates();
+
+    for (int i = 0; i < 10000 && g.next_deadline(); ++i) {
+        g.tick();
+    }
+
+    // a large hand makes a long list of playable cards
+    player_ptr origin = g.m_playing ? g.m_playing : g.m_players.front();
+    card_list deck_cards = g.m_deck;
+    for (card_ptr target_card : deck_cards | rv::take(40)) {
+        origin->add_to_hand(target_card);
+    }
+    origin->add_gold(50);
+    g.commit_updates();
+    while (g.pending_updates()) {
+        g.get_next_update();
+    }
+
+    bench_update("status_ready", g, game_update{utils::tag<"status_ready">{}, g.make_status_ready_update(origin)});
+
+    if (g.pending_requests()) {
+        bench_update("request_status", g, game_update{utils::tag<"request_status">{}, g.make_request_update(origin)});
+    } else {
+        std::println("request_status: no pending request");
+    }
+}
@@ -0,0 +1,103 @@
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+#include "utils/mpsc_queue.h"
+#include "utils/tsqueue.h"
+
+// the producers stand for the uWS threads pushing client messages, the consumer for the game thread
+
+struct message {
+    size_t producer;
+    std::string content;
+};
+
+static constexpr size_t messages_per_producer = 100000;
+
+static size_t run_tsqueue(size_t num_producers) {
+    utils::tsqueue<message> queue;
+
+    std::vector<std::jthread> producers;
+    for (size_t i=0; i<num_producers; ++i) {
+        producers.emplace_back([&queue, i]{
+            for (size_t n=0; n<messages_per_producer; ++n) {
+                queue.push(message{ i, "{\"game_action\":{}}" });
+            }
+        });
+    }
+
+    size_t received = 0;
+    size_t total_size = 0;
+    while (received < num_producers * messages_per_producer) {
+        while (auto value = queue.pop()) {
+            total_size += value->content.size();
+            ++received;
+        }
+    }
+    return total_size;
+}
+
+static size_t run_mpsc_queue(size_t num_producers) {
+    utils::mpsc_queue<message> queue{8192};
+
+    std::vector<std::jthread> producers;
+    for (size_t i=0; i<num_producers; ++i) {
+        producers.emplace_back([&queue, i]{
+            for (size_t n=0; n<messages_per_producer; ++n) {
+                message value{ i, "{\"game_action\":{}}" };
+                while (!queue.try_push(std::move(value))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    size_t received = 0;
+    size_t total_size = 0;
+    while (received < num_producers * messages_per_producer) {
+        received += queue.drain([&](message &&value) {
+            total_size += value.content.size();
+        });
+    }
+    return total_size;
+}
+
+// pushes with a reserve fail once only that many cells are free, pushes without one fill the rest
+static void check_reserve() {
+    utils::mpsc_queue<message> queue{16};
+
+    size_t pushed = 0;
+    while (queue.try_push(message{ 0, "" }, 4)) {
+        ++pushed;
+    }
+    if (pushed != 12) {
+        std::println("mpsc_queue check failed: {} pushes with a reserve of 4", pushed);
+        std::exit(1);
+    }
+    while (queue.try_push(message{ 0, "" })) {
+        ++pushed;
+    }
+    if (pushed != 16) {
+        std::println("mpsc_queue check failed: {} pushes in a queue of 16", pushed);
+        std::exit(1);
+    }
+    queue.drain([](message &&) {});
+    if (!queue.try_push(message{ 0, "" }, 15) || queue.try_push(message{ 0, "" }, 15)) {
+        std::println("mpsc_queue check failed: reserve after drain");
+        std::exit(1);
+    }
+}
+
+int main() {
+    check_reserve();
+
+    for (size_t num_producers : {1, 2, 4, 8}) {
+        size_t num_messages = num_producers * messages_per_producer;
+        std::println("{} producers, time per message:", num_producers);
+        bench::run("  tsqueue", 10, num_messages, [&]{ return run_tsqueue(num_producers); });
+        bench::run("  mpsc_queue", 10, num_messages, [&]{ return run_mpsc_queue(num_producers); });
+    }
+}
@@ -0,0 +1,131 @@
+#include <numeric>
+#include <vector>
+
+#include "bench.h"
+
+#include "game/game.h"
+#include "game/game_options.h"
+#include "game/possible_to_play.h"
+#include "cards/expansion_set.h"
+
+// generation of the playable cards list for a worst-case hand: eight players, every expansion that
+// can be enabled together, and the playing player holding the whole main deck with plenty of gold
+
+using namespace banggame;
+
+// the multi-target search before the candidates were filtered once per argument:
+// inner candidates are filtered again for every outer choice, and the sized mth_holder is built at every leaf
+static bool exhaustive_possible_mth(player_ptr origin, card_ptr origin_card, const mth_holder &mth, const effect_list &effects, target_list &targets) {
+    if (targets.size() == mth.args.size()) {
+        return !mth_holder{
+            mth.type,
+            small_int_set(small_int_set_sized_tag, targets.size())
+        }.get_error(origin_card, origin, targets, {});
+    }
+    const auto &effect = effects.at(mth.args[targets.size()]);
+    if (effect.target == TARGET_TYPE(player)) {
+        for (player_ptr target : get_all_player_targets(origin, origin_card, effect)) {
+            targets.emplace_back(utils::tag<"player">{}, target);
+            bool result = exhaustive_possible_mth(origin, origin_card, mth, effects, targets);
+            targets.pop_back();
+            if (result) return true;
+        }
+        return false;
+    } else if (effect.target == TARGET_TYPE(card)) {
+        for (card_ptr target : get_all_card_targets(origin, origin_card, effect)) {
+            targets.emplace_back(utils::tag<"card">{}, target);
+            bool result = exhaustive_possible_mth(origin, origin_card, mth, effects, targets);
+            targets.pop_back();
+            if (result) return true;
+        }
+        return false;
+    } else {
+        return true;
+    }
+}
+
+static expansion_set largest_valid_expansions() {
+    expansion_set result;
+    for (const ruleset_vtable *ruleset : all_cards.expansions) {
+        expansion_set with_ruleset = result;
+        with_ruleset.insert(ruleset);
+        if (validate_expansions(with_ruleset)) {
+            result = std::move(with_ruleset);
+        }
+    }
+    return result;
+}
+
+static void discard_updates(game &g) {
+    while (g.pending_updates()) {
+        g.get_next_update();
+    }
+}
+
+int main() {
+    // game_table keeps a reference to its options, so they have to outlive the game
+    game_options options{
+        .expansions = largest_valid_expansions(),
+        .character_choice = false,
+        .game_seed = 1
+    };
+    game g{options};
+
+    std::vector<int> user_ids(lobby_max_players);
+    std::iota(user_ids.begin(), user_ids.end(), 1);
+    g.add_players(user_ids);
+    g.start_game();
+    g.commit_updates();
+
+    for (int i = 0; i < 10000 && g.next_deadline(); ++i) {
+        g.tick();
+    }
+
+    player_ptr origin = g.m_playing ? g.m_playing : g.m_players.front();
+    card_list deck_cards = g.m_deck;
+    for (card_ptr target_card : deck_cards) {
+        origin->add_to_hand(target_card);
+    }
+    origin->add_gold(50);
+    g.commit_updates();
+    discard_updates(g);
+
+    card_list mth_cards;
+    for (card_ptr target_card : origin->m_hand) {
+        if (target_card->get_mth(false)) {
+            mth_cards.push_back(target_card);
+        }
+    }
+
+    std::println("{} players, {} cards in hand, {} with multiple targets", g.m_players.size(), origin->m_hand.size(), mth_cards.size());
+
+    constexpr size_t iterations = 200;
+
+    bench::run("generate_playable_cards_list (cold)", iterations, 1, [&]{
+        g.bump_state_epoch();
+        return generate_playable_cards_list(origin).size();
+    });
+
+    bench::run("get_playable_cards (same state)", iterations, 1, [&]{
+        return g.get_playable_cards(origin, false).size();
+    });
+
+    if (!mth_cards.empty()) {
+        bench::run("mth: exhaustive search", iterations, mth_cards.size(), [&]{
+            size_t count = 0;
+            target_list targets;
+            for (card_ptr origin_card : mth_cards) {
+                count += exhaustive_possible_mth(origin, origin_card, origin_card->get_mth(false), origin_card->get_effect_list(false), targets);
+            }
+            return count;
+        });
+
+        bench::run("mth: check_possible_mth", iterations, mth_cards.size(), [&]{
+            size_t count = 0;
+            for (card_ptr origin_card : mth_cards) {
+                count += check_possible_mth(origin, origin_card, false);
+            }
+            return count;
+        });
+    }
+}
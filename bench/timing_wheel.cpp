@@ -0,0 +1,96 @@
+#include <cstdlib>
+#include <random>
+#include <set>
+
+#include "bench.h"
+
+#include "utils/timing_wheel.h"
+
+// the timers of the server: pings, handshake timeouts, session and lobby expiry.
+// before timing anything, a random sequence of schedules and advances is checked against a sorted multiset of deadlines
+
+using wheel_type = utils::timing_wheel<uint64_t>;
+using tick_type = wheel_type::tick_type;
+
+[[noreturn]] static void check_failed(std::string_view what, size_t step) {
+    std::println("timing_wheel check failed at step {}: {}", step, what);
+    std::exit(1);
+}
+
+static void check_random_sequence(std::default_random_engine &rng, size_t steps) {
+    wheel_type wheel;
+    std::multiset<tick_type> deadlines;
+
+    // delays are picked from every level, including past the last one
+    std::uniform_int_distribution<int> level_dist{0, 4};
+    auto random_delay = [&]{
+        int level = level_dist(rng);
+        tick_type max = level == 4 ? wheel_type::max_delay * 2 : tick_type{1} << (6 * (level + 1));
+        return std::uniform_int_distribution<tick_type>{1, max}(rng);
+    };
+
+    for (size_t step = 0; step < steps; ++step) {
+        int num_schedules = std::uniform_int_distribution<int>{0, 3}(rng);
+        for (int i = 0; i < num_schedules; ++i) {
+            tick_type deadline = wheel.now() + random_delay();
+            wheel.schedule(deadline - wheel.now(), deadline);
+            deadlines.insert(deadline);
+        }
+
+        auto expiry = wheel.next_expiry();
+        if (deadlines.empty()) {
+            if (expiry) check_failed("next_expiry of an empty wheel", step);
+            continue;
+        }
+        if (!expiry) check_failed("no next_expiry with pending timers", step);
+        if (*expiry == 0) check_failed("next_expiry is zero", step);
+
+        tick_type first = *deadlines.begin() - wheel.now();
+        if (*expiry > first) check_failed("next_expiry is past the earliest deadline", step);
+
+        // either jump to the next expiry, like the server does when it sleeps, or advance by a random amount
+        tick_type elapsed = std::bernoulli_distribution{0.5}(rng)
+            ? *expiry
+            : std::uniform_int_distribution<tick_type>{1, first * 2}(rng);
+
+        wheel.advance(elapsed, [&](uint64_t deadline) {
+            if (deadline != wheel.now()) check_failed("timer expired at the wrong tick", step);
+            auto it = deadlines.find(deadline);
+            if (it != deadlines.begin()) check_failed("timer expired out of order", step);
+            deadlines.erase(it);
+        });
+
+        if (wheel.size() != deadlines.size()) check_failed("size mismatch", step);
+        if (!deadlines.empty() && *deadlines.begin() <= wheel.now()) check_failed("timer not expired", step);
+    }
+}
+
+int main() {
+    std::default_random_engine rng;
+
+    for (int i = 0; i < 100; ++i) {
+        check_random_sequence(rng, 2000);
+    }
+    std::println("next_expiry and advance match a sorted multiset of deadlines");
+
+    // 1000 clients pinged every 10 seconds, the server sleeping until the next expiry
+    constexpr size_t num_timers = 1000;
+    constexpr tick_type ping_interval = 1200;
+
+    wheel_type wheel;
+    for (size_t i = 0; i < num_timers; ++i) {
+        wheel.schedule(std::uniform_int_distribution<tick_type>{1, ping_interval}(rng), i);
+    }
+
+    bench::run("reschedule on expiry, per expired timer", 1000, num_timers, [&]{
+        size_t count = 0;
+        tick_type end = wheel.now() + ping_interval;
+        while (wheel.now() < end) {
+            wheel.advance(*wheel.next_expiry(), [&](uint64_t value) {
+                wheel.schedule(ping_interval, value);
+                ++count;
+            });
+        }
+        return count;
+    });
+}
@@ -5,6 +5,9 @@
 #include <string>
 
 #include "card_effect.h"
+#include "filter_enums.h"
+
+#include "utils/range_utils.h"
 
 namespace banggame {
 
@@ -42,15 +45,19 @@ namespace banggame {
         }
 
         bool has_tag(tag_type tag) const {
-            return tags.find(tag) != tags.end();
+            return tags.types.check(tag);
         }
 
         std::optional<short> get_tag_value(tag_type tag) const {
-            if (auto it = tags.find(tag); it != tags.end()) {
-                return it->second;
-            } else {
+            if (!has_tag(tag)) {
                 return std::nullopt;
             }
+            auto it = rn::lower_bound(tags.values, tag, {}, &tag_value_pair::type);
+            if (it != tags.values.end() && it->type == tag) {
+                return it->value;
+            } else {
+                return 0;
+            }
         }
 
         bool self_equippable() const {
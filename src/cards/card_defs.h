@@ -5,6 +5,7 @@
 
 #include "utils/tagged_variant.h"
 #include "utils/enum_bitset.h"
+#include "utils/small_vector.h"
 
 namespace banggame {
 
@@ -177,7 +178,17 @@ namespace banggame {
 
     using effect_list = std::vector<effect_holder>;
     using equip_list = std::vector<equip_holder>;
-    using tag_map = std::unordered_map<tag_type, short>;
+
+    struct tag_value_pair {
+        tag_type type;
+        short value;
+    };
+
+    // generated by parse_bang_cards.py: values is sorted by tag type and only holds the values different from 0
+    struct tag_map {
+        enums::bitset<tag_type> types;
+        std::initializer_list<tag_value_pair> values;
+    };
 
     enum class card_deck_type {
         none,
@@ -218,25 +229,36 @@ namespace banggame {
 
     class selected_cubes_count {
     private:
-        using cubes_max_pair = std::pair<card_list, int>;
-        std::unordered_map<const_card_ptr, cubes_max_pair> m_value;
+        struct cubes_entry {
+            const_card_ptr origin_card;
+            int num_cubes;
+            int max;
+        };
+
+        // one entry for each card paying with cubes, a linear search is faster than hashing
+        utils::small_vector<cubes_entry, 4> m_value;
+        utils::small_vector<card_ptr, 16> m_cubes;
 
     public:
-        void insert(const_card_ptr origin_card, card_list cubes, int max) {
+        void insert(const_card_ptr origin_card, rn::input_range auto &&cubes, int max) {
             assert(max != 0);
-            m_value.emplace(origin_card, std::pair{std::move(cubes), max});
+            if (!rn::contains(m_value, origin_card, &cubes_entry::origin_card)) {
+                m_value.push_back({origin_card, int(rn::distance(cubes)), max});
+                for (card_ptr cube : cubes) {
+                    m_cubes.push_back(cube);
+                }
+            }
         }
 
         int count(const_card_ptr origin_card) const {
-            auto it = m_value.find(origin_card);
+            auto it = rn::find(m_value, origin_card, &cubes_entry::origin_card);
             if (it == m_value.end()) return 0;
 
-            const auto &[cubes, max] = it->second;
-            return cubes.size() / max;
+            return it->num_cubes / it->max;
         }
 
-        auto all_cubes() const {
-            return m_value | rv::values | rv::for_each(&cubes_max_pair::first);
+        const auto &all_cubes() const {
+            return m_cubes;
         }
     };
 
@@ -248,9 +270,17 @@ namespace banggame {
         bool ignore_distances;
     };
 
+    // inline capacities of what a play selects, past them the small vectors spill to the heap.
+    // no card has more than two card targets or one player target. the modifiers played with it,
+    // rarely more than a couple, add themselves to the selected cards along with their own targets
+    constexpr size_t max_card_targets = 4;
+    constexpr size_t max_player_targets = 2;
+    constexpr size_t max_modifiers = 4;
+
     struct effect_context : effect_context_base {
-        player_list selected_players;
-        card_list selected_cards;
+        // kept in place so that copying a context while searching for playable cards doesn't allocate
+        utils::small_vector<player_ptr, max_player_targets> selected_players;
+        utils::small_vector<card_ptr, max_card_targets> selected_cards;
         selected_cubes_count selected_cubes;
         nullable_player skipped_player;
         nullable_card traincost;
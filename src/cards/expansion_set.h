@@ -37,6 +37,20 @@ namespace json {
 
             return *it;
         }
+
+        const banggame::ruleset_vtable *read(string_reader &in) const {
+            if (in.peek() != string_reader::value_kind::string) {
+                throw deserialize_error("Cannot deserialize ruleset_vtable");
+            }
+
+            std::string_view name = in.read_string_view();
+            auto it = rn::find(banggame::all_cards.expansions, name, &banggame::ruleset_vtable::name);
+            if (it == banggame::all_cards.expansions.end()) {
+                throw deserialize_error(std::format("Invalid ruleset_vtable name: {}", name));
+            }
+
+            return *it;
+        }
     };
 
 }
@@ -110,6 +110,15 @@ def parse_equips(equip_list):
         ))
     return result
 
+def read_enum_values(filename, enum_name):
+    with open(filename, 'r', encoding='utf8') as file:
+        match = re.search(rf'enum\s+class\s+{enum_name}\s*\{{([^}}]*)\}}', file.read())
+    if not match:
+        raise RuntimeError(f'Cannot find enum {enum_name} in {filename}')
+    return [value.strip() for value in match.group(1).split(',') if value.strip()]
+
+TAG_TYPES = read_enum_values('../cards/filter_enums.h', 'tag_type')
+
 def parse_tags(tag_list):
     if not isinstance(tag_list, list):
         raise RuntimeError(f'in parse_tags: expected list, got {tag_list}')
@@ -127,11 +136,18 @@ def parse_tags(tag_list):
         tag_type_str = match.group(1)
         tag_value = match.group(2)
 
-        tag_type = CppEnum('tag_type', tag_type_str)
-        if tag_type in result:
+        if tag_type_str not in TAG_TYPES:
+            raise RuntimeError(f'Invalid tag type: {tag_type_str}')
+        if tag_type_str in result:
             raise RuntimeError(f'Duplicate tag: {tag_type_str}')
-        result[tag_type] = int(tag_value) if tag_value else 0
-    return result
+        result[tag_type_str] = int(tag_value) if tag_value else 0
+
+    # the set of tags as a bitset, and only the values different from 0, sorted by tag type
+    sorted_tags = sorted(result.items(), key=lambda item: TAG_TYPES.index(item[0]))
+    return CppObject(
+        types = [CppEnum('tag_type', key) for key, value in sorted_tags],
+        values = [CppObject(type = CppEnum('tag_type', key), value = value) for key, value in sorted_tags if value != 0] or None
+    )
 
 def parse_mth(effect):
     match = re.match(
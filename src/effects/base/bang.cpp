@@ -29,7 +29,7 @@ namespace banggame {
     static void queue_request_bang(card_ptr origin_card, player_ptr origin, player_ptr target, effect_flags flags = {}) {
         flags.add(effect_flag::is_bang);
         flags.add(effect_flag::single_target);
-        auto req = std::make_shared<request_bang>(origin_card, origin, target, flags);
+        auto req = origin->m_game->make_request<request_bang>(origin_card, origin, target, flags);
         req->origin->m_game->call_event(event_type::apply_bang_modifier{ req->origin, req });
         req->origin->m_game->queue_request(std::move(req));
     }
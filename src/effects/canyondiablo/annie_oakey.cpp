@@ -76,7 +76,7 @@ namespace banggame {
         drawn_card->set_visibility(card_visibility::shown);
         drawn_card->add_short_pause();
 
-        req_draw->num_cards_to_draw += get_ncards(choice, drawn_card->sign);
+        req_draw->num_cards_to_draw += get_ncards(choice, drawn_card->data->sign);
         req_draw->add_to_hand_phase_one(drawn_card);
     }
 }
\ No newline at end of file
@@ -6,9 +6,11 @@
 #include "effects/base/deathsave.h"
 #include "effects/base/predraw_check.h"
 
+#include <atomic>
+
 namespace banggame {
 
-    static uint8_t brothel_counter = 0;
+    static std::atomic<uint8_t> brothel_counter = 0;
 
     game_string equip_brothel::on_prompt(card_ptr origin_card, player_ptr origin, player_ptr target) {
         MAYBE_RETURN(prompts::bot_check_target_enemy(origin, target));
@@ -27,7 +27,7 @@ namespace banggame {
             drawn_card->add_short_pause();
             target->add_to_hand(drawn_card);
 
-            if (drawn_card->sign.is_diamonds()) {
+            if (drawn_card->data->sign.is_diamonds()) {
                 target->draw_card(1, origin_card);
             }
         }
@@ -37,7 +37,7 @@ namespace banggame {
         }
 
         prompt_string resolve_prompt() const override {
-            if (target->is_bot() && drawn_card->sign.is_diamonds()) {
+            if (target->is_bot() && drawn_card->data->sign.is_diamonds()) {
                 return "BOT_BAD_PLAY";
             }
             return {};
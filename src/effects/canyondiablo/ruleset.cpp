@@ -11,7 +11,7 @@ namespace banggame {
         game->add_listener<event_type::check_damage_response>(nullptr, [=](player_ptr target, bool &value) {
             if (!value && rn::any_of(game->m_players, [target](player_ptr p) {
                 return p != target && p->alive() && !p->empty_hand();
-            }) && !rn::contains(game->m_discards, "SACRIFICE", &card::name)) {
+            }) && !rn::contains(game->m_discards, "SACRIFICE", &card::get_name)) {
                 value = true;
             }
         });
@@ -32,11 +32,11 @@ namespace banggame {
                 | rv::take_last(2)
                 | rv::transform([](const_card_ptr target_card) {
                     for (card_ptr c : target_card->m_game->get_all_cards()) {
-                        if (c != target_card && c->deck == target_card->deck && c->name == target_card->name) {
+                        if (c != target_card && c->data->deck == target_card->data->deck && c->data->name == target_card->data->name) {
                             return c;
                         }
                     }
-                    return target_card->m_game->add_card(*target_card);
+                    return target_card->m_game->add_card(*target_card->data);
                 })
                 | rn::to_vector;
 
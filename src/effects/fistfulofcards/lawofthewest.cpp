@@ -14,7 +14,7 @@ namespace banggame {
                 reveal = true;
                 event_card_key key{target_card, 1};
 
-                if (!drawn_card->is_brown() || !drawn_card->effects.empty()) {
+                if (!drawn_card->is_brown() || !drawn_card->data->effects.empty()) {
                     origin->m_game->add_log("LOG_MANDATORY_CARD", origin, drawn_card);
                 }
                 
@@ -8,7 +8,7 @@ namespace banggame {
 
     void equip_russianroulette::on_enable(card_ptr target_card, player_ptr target) {
         auto queue_russianroulette_request = [=](player_ptr target) {
-            auto req = std::make_shared<request_bang>(target_card, nullptr, target, effect_flags{}, 0);
+            auto req = target->m_game->make_request<request_bang>(target_card, nullptr, target, effect_flags{}, 0);
             req->bang_damage = 2;
             target->m_game->queue_request(std::move(req));
         };
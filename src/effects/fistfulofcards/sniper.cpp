@@ -15,7 +15,7 @@ namespace banggame {
 
     void effect_sniper::on_play(card_ptr origin_card, player_ptr origin, player_ptr target) {
         target->m_game->add_log("LOG_PLAYED_CARD_ON", origin_card, origin, target);
-        auto req = std::make_shared<request_bang>(origin_card, origin, target);
+        auto req = origin->m_game->make_request<request_bang>(origin_card, origin, target);
         req->bang_strength = 2;
         target->m_game->queue_request(std::move(req));
     }
@@ -5,7 +5,7 @@
 namespace banggame {
 
     bool modifier_discount::valid_with_card(card_ptr origin_card, player_ptr origin, card_ptr target_card) {
-        return target_card->deck == card_deck_type::goldrush
+        return target_card->data->deck == card_deck_type::goldrush
             && target_card->pocket != pocket_type::player_table;
     }
 
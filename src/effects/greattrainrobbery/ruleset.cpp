@@ -10,7 +10,7 @@ namespace banggame {
 
     static void init_stations_and_train(player_ptr origin) {
         origin->m_game->m_stations = origin->m_game->get_all_cards()
-            | rv::filter([](card_ptr c) { return c->deck == card_deck_type::station; })
+            | rv::filter([](card_ptr c) { return c->data->deck == card_deck_type::station; })
             | rv::sample(std::max(int(origin->m_game->m_players.size()), 4), origin->m_game->rng)
             | rn::to_vector;
             
@@ -22,7 +22,7 @@ namespace banggame {
 
         origin->m_game->m_train = origin->m_game->get_all_cards()
             | rv::filter([&](card_ptr c) {
-                return c->deck == card_deck_type::locomotive && !rn::contains(origin->m_game->m_train, c);
+                return c->data->deck == card_deck_type::locomotive && !rn::contains(origin->m_game->m_train, c);
             })
             | rv::sample(1, origin->m_game->rng)
             | rn::to_vector;
@@ -76,7 +76,7 @@ namespace banggame {
             if (origin_card->is_equip_card() && origin_card->is_train()) {
                 if (!ctx.traincost) {
                     out_error = "ERROR_MUST_PAY_TRAIN_COST";
-                } else if (ctx.traincost->deck != card_deck_type::main_deck) {
+                } else if (ctx.traincost->data->deck != card_deck_type::main_deck) {
                     int train_equips = 0;
                     int num_advance = 0;
                     origin->m_game->call_event(event_type::count_train_equips{ origin, train_equips, num_advance });
@@ -91,7 +91,7 @@ namespace banggame {
 
         game->add_listener<event_type::on_equip_card>(nullptr, [](player_ptr origin, player_ptr target, card_ptr origin_card, const effect_context &ctx) {
             if (origin_card->is_train()) {
-                if (ctx.traincost->deck != card_deck_type::main_deck) {
+                if (ctx.traincost->data->deck != card_deck_type::main_deck) {
                     event_card_key key{origin_card, 5};
                     origin->m_game->add_listener<event_type::count_train_equips>(key, [=](player_ptr p, int &train_equips, int &num_advance) {
                         if (origin == p) {
@@ -60,11 +60,11 @@ namespace banggame {
 
     game_string handler_switch_cards::get_error(card_ptr origin_card, player_ptr origin, card_ptr chosen_card, card_ptr target_card) {
         player_ptr target = target_card->owner;
-        MAYBE_RETURN(check_player_filter(target_card, origin, target_card->equip_target, origin));
+        MAYBE_RETURN(check_player_filter(target_card, origin, target_card->data->equip_target, origin));
         if (auto *c = origin->find_equipped_card(target_card)) {
             return {"ERROR_DUPLICATED_CARD", c};
         }
-        MAYBE_RETURN(check_player_filter(chosen_card, target, chosen_card->equip_target, target));
+        MAYBE_RETURN(check_player_filter(chosen_card, target, chosen_card->data->equip_target, target));
         if (auto *c = target->find_equipped_card(chosen_card)) {
             return {"ERROR_DUPLICATED_CARD", c};
         }
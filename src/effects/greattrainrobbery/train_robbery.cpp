@@ -9,12 +9,14 @@
 #include "cards/game_enums.h"
 #include "cards/filter_enums.h"
 
+#include "utils/id_bitset.h"
+
 namespace banggame {
 
     struct request_train_robbery : request_base, interface_target_set_cards {
         using request_base::request_base;
 
-        std::set<const_card_ptr> selected_cards;
+        utils::id_bitset<> selected_cards;
 
         void on_update() override {
             if (!target->alive() || target->immune_to(origin_card, origin, flags)
@@ -28,7 +30,7 @@ namespace banggame {
 
         bool in_target_set(const_card_ptr target_card) const override {
             return target_card->pocket == pocket_type::player_table && target_card->owner == target
-                && !target_card->is_black() && !selected_cards.contains(target_card);
+                && !target_card->is_black() && !selected_cards.contains(target_card->id);
         }
 
         game_string status_text(player_ptr owner) const override {
@@ -64,7 +66,7 @@ namespace banggame {
 
     void effect_train_robbery_response::on_play(card_ptr origin_card, player_ptr origin, card_ptr target_card) {
         auto req = origin->m_game->top_request<request_train_robbery>();
-        req->selected_cards.insert(target_card);
+        req->selected_cards.insert(target_card->id);
 
         req->flags.remove(effect_flag::escapable);
         req->flags.remove(effect_flag::single_target);
@@ -39,7 +39,7 @@ namespace banggame {
 
         target->m_game->add_listener<event_type::check_play_card>({origin_card, 1},
             [origin_card, target, suit=suit](player_ptr origin, card_ptr c, const effect_context &ctx, game_string &out_error) {
-                if (c->pocket == pocket_type::player_hand && c->owner == target && c->sign.suit != suit) {
+                if (c->pocket == pocket_type::player_hand && c->owner == target && c->data->sign.suit != suit) {
                     out_error = {"ERROR_INVALID_SUIT", origin_card, c};
                 }
             });
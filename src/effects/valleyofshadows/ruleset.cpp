@@ -11,7 +11,7 @@ namespace banggame {
         game->add_listener<event_type::apply_escapable_modifier>(nullptr, [](card_ptr origin_card, player_ptr origin, const_player_ptr target, effect_flags flags, int &value) {
             if (!target->empty_hand()
                 && flags.check(effect_flag::escapable)
-                && !rn::contains(target->m_game->m_discards, "ESCAPE", &card::name)
+                && !rn::contains(target->m_game->m_discards, "ESCAPE", &card::get_name)
             ) {
                 value = 1;
             }
@@ -20,7 +20,7 @@ namespace banggame {
         game->add_listener<event_type::check_damage_response>(nullptr, [](player_ptr target, bool &value) {
             if (!value && rn::any_of(target->m_game->m_players, [&](player_ptr p) {
                 return p != target && p->alive() && !p->empty_hand();
-            }) && !rn::contains(target->m_game->m_discards, "SAVED", &card::name)) {
+            }) && !rn::contains(target->m_game->m_discards, "SAVED", &card::get_name)) {
                 value = true;
             }
         });
@@ -32,7 +32,7 @@ namespace banggame {
                 && flags.check(effect_flag::escapable)
                 && flags.check(effect_flag::single_target)
                 && !flags.check(effect_flag::multi_target)
-                && !rn::contains(target->m_game->m_discards, "ESCAPE", &card::name)
+                && !rn::contains(target->m_game->m_discards, "ESCAPE", &card::get_name)
             ) {
                 value = 1;
             }
@@ -41,7 +41,7 @@ namespace banggame {
         game->add_listener<event_type::check_damage_response>(nullptr, [](player_ptr target, bool &value) {
             if (!value && rn::any_of(target->m_game->m_players, [&](player_ptr p) {
                 return p != target && p != target->m_game->m_playing && p->alive() && !p->empty_hand();
-            }) && !rn::contains(target->m_game->m_discards, "SAVED", &card::name)) {
+            }) && !rn::contains(target->m_game->m_discards, "SAVED", &card::get_name)) {
                 value = true;
             }
         });
@@ -7,7 +7,7 @@ namespace banggame {
     static bool is_playing_card_pair(const card_pocket_pair &pair) {
         return pair.pocket == pocket_type::player_hand
             || pair.pocket == pocket_type::shop_selection
-            || pair.pocket == pocket_type::train && pair.origin_card->deck == card_deck_type::train;
+            || pair.pocket == pocket_type::train && pair.origin_card->data->deck == card_deck_type::train;
     }
 
     void equip_miss_susanna::on_enable(card_ptr target_card, player_ptr target) {
@@ -101,7 +101,7 @@ namespace banggame {
 
         if (pending_requests()) {
             for (player_ptr origin : m_players | rv::filter(&player::is_bot)) {
-                playable_cards_list play_cards = generate_playable_cards_list(origin, true);
+                playable_cards_list play_cards = get_playable_cards(origin, true);
                 
                 if (!play_cards.empty()) {
                     std::optional<timer_id_t> timer_id;
@@ -115,7 +115,7 @@ namespace banggame {
                 }
             }
         } else if (m_playing && m_playing->is_bot()) {
-            playable_cards_list play_cards = generate_playable_cards_list(m_playing);
+            playable_cards_list play_cards = get_playable_cards(m_playing, false);
             return execute_random_play(m_playing, false, std::nullopt, play_cards);
         }
         return utils::tag<"done">{};
@@ -14,7 +14,7 @@ namespace banggame {
         case pocket_type::shop_selection:
             return !is_brown();
         case pocket_type::train:
-            return deck != card_deck_type::locomotive;
+            return data->deck != card_deck_type::locomotive;
         default:
             return false;
         }
@@ -36,7 +36,7 @@ namespace banggame {
     }
     
     card_sign card::get_modified_sign() const {
-        auto value = sign;
+        auto value = data->sign;
         m_game->call_event(event_type::apply_sign_modifier{ value });
         return value;
     }
@@ -52,9 +52,9 @@ namespace banggame {
             visibility = card_visibility::hidden;
         } else if (!new_owner || new_visibility == card_visibility::shown) {
             if (visibility == card_visibility::show_owner) {
-                m_game->add_update<"show_card">(update_target::excludes(owner), this, *this, duration);
+                m_game->add_update<"show_card">(update_target::excludes(owner), this, data, duration);
             } else if (visibility == card_visibility::hidden) {
-                m_game->add_update<"show_card">(this, *this, duration);
+                m_game->add_update<"show_card">(this, data, duration);
             }
             visibility = card_visibility::shown;
         } else if (owner != new_owner || visibility != card_visibility::show_owner) {
@@ -64,27 +64,37 @@ namespace banggame {
                 if (visibility == card_visibility::show_owner) {
                     m_game->add_update<"hide_card">(update_target::includes(owner), this, duration);
                 }
-                m_game->add_update<"show_card">(update_target::includes(new_owner), this, *this, duration);
+                m_game->add_update<"show_card">(update_target::includes(new_owner), this, data, duration);
             }
             visibility = card_visibility::show_owner;
         }
     }
 
+    static card_list::iterator find_in_pocket(card_list &pile, const_card_ptr target) {
+        if (target->pocket_index < pile.size() && pile[target->pocket_index] == target) {
+            return pile.begin() + target->pocket_index;
+        }
+        // cards are mostly added to and taken from the end of a pile
+        return std::prev(std::find(pile.rbegin(), pile.rend(), target).base());
+    }
+
     void card::move_to(pocket_type new_pocket, player_ptr new_owner, card_visibility new_visibility, bool instant, bool front) {
         if (pocket == new_pocket && owner == new_owner) return;
         
         set_visibility(new_visibility, new_owner, instant);
 
         auto &prev_pile = m_game->get_pocket(pocket, owner);
-        prev_pile.erase(rn::find(prev_pile, this));
+        prev_pile.erase(find_in_pocket(prev_pile, this));
 
         pocket = new_pocket;
         owner = new_owner;
 
         auto &new_pile = m_game->get_pocket(new_pocket, new_owner);
         if (front) {
+            pocket_index = 0;
             new_pile.insert(new_pile.begin(), this);
         } else {
+            pocket_index = new_pile.size();
             new_pile.push_back(this);
         }
         
@@ -136,7 +146,7 @@ namespace banggame {
             m_game->add_log("LOG_PAID_CUBE", owner, this, ncubes);
             m_game->add_update<"move_cubes">(ncubes, this, nullptr, instant ? 0ms : ncubes == 1 ? durations.move_cube : durations.move_cubes);
         }
-        if (sign && num_cubes == 0) {
+        if (data->sign && num_cubes == 0) {
             m_game->add_log("LOG_DISCARDED_ORANGE_CARD", owner, this);
             m_game->call_event(event_type::on_discard_orange_card{ owner, this });
             owner->disable_equip(this);
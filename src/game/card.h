@@ -19,9 +19,12 @@ namespace banggame {
         show_owner
     };
     
-    struct card : card_data {
+    struct card {
         card(game *game, int id, const card_data &data)
-            : card_data(data), m_game(game), order(id), id(id) {}
+            : data(&data), m_game(game), order(id), id(id) {}
+
+        // points to the static definition in all_cards, shared by every game
+        const card_data *data;
         
         const int order;
         int id;
@@ -34,6 +37,26 @@ namespace banggame {
         bool inactive = false;
         int8_t num_cubes = 0;
 
+        // position in the pocket where the card was last moved, can be stale after other cards are moved
+        size_t pocket_index = 0;
+
+        const std::string &get_name() const { return data->name; }
+
+        const effect_list &get_effect_list(bool is_response) const { return data->get_effect_list(is_response); }
+        const mth_holder &get_mth(bool is_response) const { return data->get_mth(is_response); }
+        const modifier_holder &get_modifier(bool is_response) const { return data->get_modifier(is_response); }
+
+        bool has_tag(tag_type tag) const { return data->has_tag(tag); }
+        std::optional<short> get_tag_value(tag_type tag) const { return data->get_tag_value(tag); }
+        bool self_equippable() const { return data->self_equippable(); }
+
+        bool is_brown() const { return data->is_brown(); }
+        bool is_blue() const { return data->is_blue(); }
+        bool is_green() const { return data->is_green(); }
+        bool is_black() const { return data->is_black(); }
+        bool is_orange() const { return data->is_orange(); }
+        bool is_train() const { return data->is_train(); }
+
         bool is_equip_card() const;
         bool is_bang_card(const_player_ptr origin) const;
         int get_card_cost(const effect_context &ctx) const;
@@ -34,7 +34,7 @@ namespace banggame {
     void disabler_map::add_disabler(event_card_key key, card_disabler_fun &&fun) {
         for (auto [owner, c] : disableable_cards(m_game)) {
             if (!is_disabled(c) && std::invoke(fun, c)) {
-                for (const equip_holder &holder : c->equips | rv::reverse) {
+                for (const equip_holder &holder : c->data->equips | rv::reverse) {
                     if (!holder.is_nodisable()) {
                         holder.on_disable(c, owner);
                     }
@@ -44,21 +44,17 @@ namespace banggame {
 
         logging::debug("add_disabler() on {}: {}", key, utils::demangle(fun.target_type().name()));
         m_disablers.emplace(key, std::move(fun));
+        ++m_epoch;
     }
 
     void disabler_map::do_remove_disablers(disabler_map_range range) {
         for (auto [owner, c] : disableable_cards(m_game)) {
-            bool a = false;
-            bool b = false;
-            for (const auto &[key, fun] : m_disablers) {
-                if (rn::none_of(range, [&](const auto &pair) { return pair.first == key; })) {
-                    a = a || std::invoke(fun, c);
-                } else {
-                    b = b || std::invoke(fun, c);
-                }
-            }
-            if (!a && b) {
-                for (const equip_holder &holder : c->equips) {
+            // a card is enabled again if it's disabled now, but by none of the disablers outside of range
+            if (is_disabled(c)
+                && !find_disabler(m_disablers.begin(), range.begin(), c, false)
+                && !find_disabler(range.end(), m_disablers.end(), c, false)
+            ) {
+                for (const equip_holder &holder : c->data->equips) {
                     if (!holder.is_nodisable()) {
                         holder.on_enable(c, owner);
                     }
@@ -71,10 +67,11 @@ namespace banggame {
         }
 
         m_disablers.erase(range.begin(), range.end());
+        ++m_epoch;
     }
 
-    card_ptr disabler_map::get_disabler(const_card_ptr target_card, bool check_disable_use) const {
-        for (auto &[card_key, fun] : m_disablers) {
+    card_ptr disabler_map::find_disabler(disabler_map_iterator begin, disabler_map_iterator end, const_card_ptr target_card, bool check_disable_use) const {
+        for (auto &[card_key, fun] : rn::subrange(begin, end)) {
             if ((!check_disable_use || fun.is_disable_use()) && std::invoke(fun, target_card)) {
                 return card_key.target_card;
             }
@@ -82,4 +79,16 @@ namespace banggame {
         return nullptr;
     }
 
+    auto disabler_map::get_cached_disabler(const_card_ptr target_card) const -> const cached_disabler & {
+        cached_disabler &cached = m_cache[target_card];
+        if (cached.epoch != m_epoch || cached.pocket != target_card->pocket || cached.owner != target_card->owner) {
+            cached.epoch = m_epoch;
+            cached.pocket = target_card->pocket;
+            cached.owner = target_card->owner;
+            cached.disabler = find_disabler(m_disablers.begin(), m_disablers.end(), target_card, false);
+            cached.usage_disabler = find_disabler(m_disablers.begin(), m_disablers.end(), target_card, true);
+        }
+        return cached;
+    }
+
 }
\ No newline at end of file
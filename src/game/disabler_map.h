@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <typeindex>
+#include <unordered_map>
 #include <map>
 
 #include "event_card_key.h"
@@ -43,12 +44,27 @@ namespace banggame {
         using disabler_map_iterator = disabler_map_t::const_iterator;
         using disabler_map_range = rn::subrange<disabler_map_iterator>;
 
+        // every disabler only looks at the card's pocket and owner, so a result stays valid until either changes
+        struct cached_disabler {
+            size_t epoch = 0;
+            pocket_type pocket;
+            player_ptr owner;
+            card_ptr disabler;
+            card_ptr usage_disabler;
+        };
+
     private:
         disabler_map_t m_disablers;
         game_table *m_game;
 
+        mutable std::unordered_map<const_card_ptr, cached_disabler> m_cache;
+        size_t m_epoch = 1;
+
         void do_remove_disablers(disabler_map_range range);
 
+        card_ptr find_disabler(disabler_map_iterator begin, disabler_map_iterator end, const_card_ptr target_card, bool check_disable_use) const;
+        const cached_disabler &get_cached_disabler(const_card_ptr target_card) const;
+
     public:
         disabler_map(game_table *game): m_game(game) {}
 
@@ -64,7 +80,10 @@ namespace banggame {
             do_remove_disablers({low, high});
         }
 
-        card_ptr get_disabler(const_card_ptr target_card, bool check_disable_use = false) const;
+        card_ptr get_disabler(const_card_ptr target_card, bool check_disable_use = false) const {
+            const cached_disabler &cached = get_cached_disabler(target_card);
+            return check_disable_use ? cached.usage_disabler : cached.disabler;
+        }
 
         bool is_disabled(const_card_ptr target_card, bool check_disable_use = false) const {
             return get_disabler(target_card, check_disable_use) != nullptr;
@@ -77,6 +96,10 @@ namespace banggame {
         bool is_usage_disabled(const_card_ptr target_card) const {
             return is_disabled(target_card, true);
         }
+
+        size_t disablers_version() const {
+            return m_epoch;
+        }
     };
 }
 
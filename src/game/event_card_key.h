@@ -50,7 +50,7 @@ namespace std {
 
         auto format(banggame::card_ptr target_card, std::format_context &ctx) const {
             return std::format_to(ctx.out(), "{}", target_card
-                ? std::string_view(target_card->name)
+                ? std::string_view(target_card->data->name)
                 : std::string_view("(unknown card)")
             );
         }
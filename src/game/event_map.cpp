@@ -4,16 +4,6 @@
 #include "utils/type_name.h"
 
 namespace std {
-    template<> struct formatter<banggame::event_listener_key> {
-        constexpr auto parse(std::format_parse_context &ctx) {
-            return ctx.begin();
-        }
-
-        auto format(const banggame::event_listener_key &value, std::format_context &ctx) const {
-            return std::format_to(ctx.out(), "{}: [{}]", value.key, utils::demangle(value.type.name()));
-        }
-    };
-
     template<> struct formatter<banggame::event_listener> : formatter<std::string_view> {
         auto format(const banggame::event_listener &value, std::format_context &ctx) const {
             return formatter<std::string_view>::format(utils::demangle(value.target_type().name()), ctx);
@@ -22,50 +12,80 @@ namespace std {
 }
 
 namespace banggame {
+
+    static void log_listener(std::string_view message, const event_card_key &key, const event_listener &listener) {
+        logging::debug("{}() on {}: [{}] {}", message, key, utils::demangle(listener.event_type().name()), listener);
+    }
     
-    void listener_map::do_add_listener(event_listener_key key, event_listener &&listener) {
-        auto it = m_listeners.emplace(key, std::move(listener));
-        logging::debug("add_listener() on {} {}", it->first, it->second);
-        m_map.emplace(key.key, it);
+    void listener_map::do_add_listener(size_t type, event_card_key key, event_listener &&listener) {
+        if (type >= m_buckets.size()) {
+            m_buckets.resize(type + 1);
+        }
+        listener_bucket &bucket = m_buckets[type];
+
+        // listeners with the same priority are called in the order they were added
+        auto it = rn::upper_bound(bucket, key, [](const event_card_key &lhs, const event_card_key &rhs) {
+            return lhs.priority_compare(rhs) < 0;
+        }, &listener_entry::key);
+        size_t index = it - bucket.begin();
+
+        auto &entry = *bucket.emplace(it, key, std::make_unique<event_listener>(std::move(listener)));
+        log_listener("add_listener", entry.key, *entry.listener);
+        m_map.emplace(key, listener_handle{ type, entry.listener.get() });
+        ++m_version;
+
+        for (bucket_cursor &cursor : m_cursors) {
+            if (cursor.type == type && index < cursor.index) {
+                ++cursor.index;
+            }
+        }
     }
 
     void listener_map::do_remove_listeners(iterator_map_range range) {
         if (range.empty()) return;
 
-        for (auto it : range | rv::values) {
-            auto &[key, listener] = *it;
-            if (listener.is_active()) {
-                logging::debug("remove_listener() on {} {}", key, listener);
-                if (m_lock) {
-                    m_to_remove.push_back(it);
-                    listener.deactivate();
-                } else {
-                    m_listeners.erase(it);
-                }
+        for (const auto &[key, handle] : range) {
+            if (handle.listener->is_active()) {
+                log_listener("remove_listener", key, *handle.listener);
+                handle.listener->deactivate();
+                m_to_remove.push_back(handle.type);
             }
         }
         m_map.erase(range.begin(), range.end());
+        ++m_version;
+
+        if (m_cursors.empty()) {
+            remove_inactive_listeners();
+        }
     }
 
-    void listener_map::do_call_event(std::type_index type, const void *tuple) {
-        auto [low, high] = m_listeners.equal_range(type);
-        rn::subrange range(low, high);
-        if (range.empty()) return;
+    void listener_map::remove_inactive_listeners() {
+        rn::sort(m_to_remove);
+        for (size_t type : m_to_remove | rv::unique) {
+            std::erase_if(m_buckets[type], [](const listener_entry &entry) {
+                return !entry.listener->is_active();
+            });
+        }
+        m_to_remove.clear();
+    }
 
-        ++m_lock;
-        for (auto &[key, listener] : range) {
-            if (key.type == type && listener.is_active()) {
-                logging::trace("call_event() on {} {}", key, listener);
-                std::invoke(listener, tuple);
+    void listener_map::do_call_event(size_t type, const void *tuple) {
+        // indices instead of iterators: listeners may add other listeners to this same bucket
+        size_t cursor = m_cursors.size();
+        m_cursors.emplace_back(type, 0);
+
+        while (m_cursors[cursor].index < m_buckets[type].size()) {
+            auto &[key, listener] = m_buckets[type][m_cursors[cursor].index++];
+            if (listener->is_active()) {
+                logging::trace("call_event() on {}: {}", key, *listener);
+                std::invoke(*listener, tuple);
             }
         }
-        --m_lock;
-        
-        if (!m_lock && !m_to_remove.empty()) {
-            for (listener_iterator listener : m_to_remove) {
-                m_listeners.erase(listener);
-            }
-            m_to_remove.clear();
+
+        m_cursors.pop_back();
+
+        if (m_cursors.empty() && !m_to_remove.empty()) {
+            remove_inactive_listeners();
         }
     }
-}
\ No newline at end of file
+}
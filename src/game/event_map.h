@@ -6,7 +6,6 @@
 #include <functional>
 #include <memory>
 #include <vector>
-#include <set>
 #include <map>
 
 #include "event_card_key.h"
@@ -31,26 +30,21 @@ namespace banggame {
         std::apply(fun, tup);
     };
 
-    struct event_listener_key {
-        std::type_index type;
-        event_card_key key;
-
-        auto operator <=> (const event_listener_key &other) const {
-            if (type == other.type) {
-                return key.priority_compare(other.key);
-            } else {
-                return type <=> other.type;
-            }
+    namespace detail {
+        inline size_t next_event_id() {
+            static size_t counter = 0;
+            return counter++;
         }
+    }
 
-        auto operator <=> (std::type_index other_type) const {
-            return type <=> other_type;
-        }
-    };
+    // dense index of each event type, used to find its listeners without hashing or comparing type_index
+    template<event T>
+    inline const size_t event_id = detail::next_event_id();
 
     class event_listener {
     private:
         std::move_only_function<void(const void *tuple)> m_fun;
+        std::type_index m_event_type;
         std::type_index m_type;
         bool m_active = true;
     
@@ -60,12 +54,17 @@ namespace banggame {
             : m_fun{[fun=std::move(fun)](const void *tuple) mutable {
                 std::apply(fun, *static_cast<const event_tuple<T> *>(tuple));
             }},
+            m_event_type{typeid(T)},
             m_type{typeid(Function)} {}
         
         void operator()(const void *tuple) {
             m_fun(tuple);
         }
 
+        const std::type_index &event_type() const {
+            return m_event_type;
+        }
+
         const std::type_index &target_type() const {
             return m_type;
         }
@@ -81,31 +80,48 @@ namespace banggame {
 
     class listener_map {
     private:
-        using listener_set = std::multimap<event_listener_key, event_listener, std::less<>>;
-        using listener_iterator = listener_set::iterator;
+        // listeners are kept on the heap so that they don't move while they're called
+        struct listener_entry {
+            event_card_key key;
+            std::unique_ptr<event_listener> listener;
+        };
 
-        using iterator_map = std::multimap<event_card_key, listener_iterator, std::less<>>;
+        // all listeners of an event type, sorted by priority
+        using listener_bucket = std::vector<listener_entry>;
+
+        struct listener_handle {
+            size_t type;
+            event_listener *listener;
+        };
+
+        using iterator_map = std::multimap<event_card_key, listener_handle, std::less<>>;
         using iterator_map_iterator = iterator_map::const_iterator;
         using iterator_map_range = rn::subrange<iterator_map_iterator>;
-        
-        using iterator_vector = std::vector<listener_iterator>;
+
+        // position of a call_event in progress, moved forward when a listener is inserted before it
+        struct bucket_cursor {
+            size_t type;
+            size_t index;
+        };
 
     private:
-        listener_set m_listeners;
+        std::vector<listener_bucket> m_buckets;
         iterator_map m_map;
-        iterator_vector m_to_remove;
+        std::vector<size_t> m_to_remove;
+        std::vector<bucket_cursor> m_cursors;
 
-        int m_lock = 0;
+        size_t m_version = 0;
 
     private:
-        void do_add_listener(event_listener_key key, event_listener &&listener);
+        void do_add_listener(size_t type, event_card_key key, event_listener &&listener);
         void do_remove_listeners(iterator_map_range range);
-        void do_call_event(std::type_index type, const void *tuple);
+        void do_call_event(size_t type, const void *tuple);
+        void remove_inactive_listeners();
 
     public:
         template<event T, typename Function> requires applicable<Function, event_tuple<T>>
         void add_listener(event_card_key key, Function &&fun) {
-            do_add_listener({ typeid(T), key }, { std::in_place_type<T>, std::forward<Function>(fun) });
+            do_add_listener(event_id<T>, key, { std::in_place_type<T>, std::forward<Function>(fun) });
         }
 
         void remove_listeners(event_card_key key) {
@@ -118,10 +134,17 @@ namespace banggame {
             do_remove_listeners({low, high});
         }
 
+        size_t listeners_version() const {
+            return m_version;
+        }
+
         template<event T>
         void call_event(const T &value) {
-            auto tuple = to_event_tuple(value);
-            do_call_event(typeid(T), &tuple);
+            size_t type = event_id<T>;
+            if (type < m_buckets.size() && !m_buckets[type].empty()) {
+                auto tuple = to_event_tuple(value);
+                do_call_event(type, &tuple);
+            }
         }
     };
 
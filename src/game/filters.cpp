@@ -137,35 +137,35 @@ namespace banggame {
         if (filter.check(target_card_filter::black) != target->is_black())
             return "ERROR_TARGET_BLACK_CARD";
 
-        if (filter.check(target_card_filter::hearts) && !target->sign.is_hearts())
+        if (filter.check(target_card_filter::hearts) && !target->data->sign.is_hearts())
             return "ERROR_TARGET_NOT_HEARTS";
 
-        if (filter.check(target_card_filter::diamonds) && !target->sign.is_diamonds())
+        if (filter.check(target_card_filter::diamonds) && !target->data->sign.is_diamonds())
             return "ERROR_TARGET_NOT_DIAMONDS";
 
-        if (filter.check(target_card_filter::clubs) && !target->sign.is_clubs())
+        if (filter.check(target_card_filter::clubs) && !target->data->sign.is_clubs())
             return "ERROR_TARGET_NOT_CLUBS";
         
-        if (filter.check(target_card_filter::spades) && !target->sign.is_spades())
+        if (filter.check(target_card_filter::spades) && !target->data->sign.is_spades())
             return "ERROR_TARGET_NOT_SPADES";
         
         if (filter.check(target_card_filter::origin_card_suit)) {
             auto req = origin->m_game->top_request();
             card_ptr req_origin_card = req ? req->origin_card : nullptr;
             if (!req_origin_card) return "ERROR_NO_ORIGIN_CARD_SUIT";
-            switch (req_origin_card->sign.suit) {
-                case card_suit::hearts: if (!target->sign.is_hearts()) { return "ERROR_TARGET_NOT_HEARTS"; } break;
-                case card_suit::diamonds: if (!target->sign.is_diamonds()) { return "ERROR_TARGET_NOT_DIAMONDS"; } break;
-                case card_suit::clubs: if (!target->sign.is_clubs()) { return "ERROR_TARGET_NOT_CLUBS"; } break;
-                case card_suit::spades: if (!target->sign.is_spades()) { return "ERROR_TARGET_NOT_SPADES"; } break;
+            switch (req_origin_card->data->sign.suit) {
+                case card_suit::hearts: if (!target->data->sign.is_hearts()) { return "ERROR_TARGET_NOT_HEARTS"; } break;
+                case card_suit::diamonds: if (!target->data->sign.is_diamonds()) { return "ERROR_TARGET_NOT_DIAMONDS"; } break;
+                case card_suit::clubs: if (!target->data->sign.is_clubs()) { return "ERROR_TARGET_NOT_CLUBS"; } break;
+                case card_suit::spades: if (!target->data->sign.is_spades()) { return "ERROR_TARGET_NOT_SPADES"; } break;
                 default: return "ERROR_NO_ORIGIN_CARD_SUIT";
             }
         }
         
-        if (filter.check(target_card_filter::two_to_nine) && !target->sign.is_two_to_nine())
+        if (filter.check(target_card_filter::two_to_nine) && !target->data->sign.is_two_to_nine())
             return "ERROR_TARGET_NOT_TWO_TO_NINE";
         
-        if (filter.check(target_card_filter::ten_to_ace) && !target->sign.is_ten_to_ace())
+        if (filter.check(target_card_filter::ten_to_ace) && !target->data->sign.is_ten_to_ace())
             return "ERROR_TARGET_NOT_TEN_TO_ACE";
 
         if (filter.check(target_card_filter::table) && target->pocket != pocket_type::player_table)
@@ -26,22 +26,10 @@ namespace banggame {
     }
     
     ticks game::get_total_update_time() const {
-        game_duration result{0};
-        for (player_ptr p : m_players) {
-            game_duration player_result{0};
-            for (const auto &[target, content, duration] : m_updates) {
-                if (duration >= game_duration{0} && target.matches(p)) {
-                    player_result += duration;
-                }
-            }
-            if (player_result > result) {
-                result = player_result;
-            }
-        }
-        return std::chrono::duration_cast<ticks>(transform_duration(result));
+        return std::chrono::duration_cast<ticks>(transform_duration(get_max_pending_duration()));
     }
 
-    std::generator<json::json> game::get_spectator_join_updates() {
+    std::generator<serialized_update> game::get_spectator_join_updates() {
         co_yield make_update<"player_add">(m_players);
 
         for (player_ptr p : m_players) {
@@ -50,14 +38,14 @@ namespace banggame {
 
         co_yield make_update<"player_order">(make_player_order_update(true));
 
-        auto add_cards = [&](pocket_type pocket, player_ptr owner = nullptr) -> std::generator<json::json> {
+        auto add_cards = [&](pocket_type pocket, player_ptr owner = nullptr) -> std::generator<serialized_update> {
             auto &range = get_pocket(pocket, owner);
             if (!range.empty()) {
                 co_yield make_update<"add_cards">(range, pocket, owner);
             }
             for (card_ptr c : range) {
                 if (c->visibility == card_visibility::shown) {
-                    co_yield make_update<"show_card">(c, *c, 0ms);
+                    co_yield make_update<"show_card">(c, c->data, 0ms);
                 }
                 if (c->num_cubes > 0) {
                     co_yield make_update<"add_cubes">(c->num_cubes, c);
@@ -125,7 +113,7 @@ namespace banggame {
         co_yield make_update<"game_flags">(m_game_flags);
     }
 
-    std::generator<json::json> game::get_game_log_updates(player_ptr target) {
+    std::generator<serialized_update> game::get_game_log_updates(player_ptr target) {
         co_yield make_update<"clear_logs">();
         
         for (const auto &[upd_target, log] : m_saved_log) {
@@ -135,7 +123,7 @@ namespace banggame {
         }
     }
 
-    std::generator<json::json> game::get_rejoin_updates(player_ptr target) {
+    std::generator<serialized_update> game::get_rejoin_updates(player_ptr target) {
         co_yield make_update<"player_add">(target);
 
         if (!target->check_player_flags(player_flag::role_revealed)) {
@@ -143,12 +131,12 @@ namespace banggame {
         }
 
         for (card_ptr c : target->m_hand) {
-            co_yield make_update<"show_card">(c, *c, 0ms);
+            co_yield make_update<"show_card">(c, c->data, 0ms);
         }
 
         for (card_ptr c : m_selection) {
             if (c->owner == target) {
-                co_yield make_update<"show_card">(c, *c, 0ms);
+                co_yield make_update<"show_card">(c, c->data, 0ms);
             }
         }
 
@@ -170,7 +158,9 @@ namespace banggame {
 
         int player_id = 0;
         for (int id : user_ids) {
-            m_players.emplace_back(&m_players_storage.emplace(this, ++player_id, id));
+            player_ptr p = &m_players_storage.emplace(this, ++player_id, id);
+            m_players.emplace_back(p);
+            add_update_recipient(p);
         }
     }
 
@@ -363,6 +353,24 @@ namespace banggame {
         };
     }
     
+    const playable_cards_list &game::get_playable_cards(player_ptr owner, bool is_response) {
+        return m_playable_cards_cache.get(state_epoch(), std::pair{owner, is_response}, [&]{
+            return generate_playable_cards_list(owner, is_response);
+        });
+    }
+
+    const player_distances &game::get_player_distances(player_ptr owner) {
+        return m_distances_cache.get(state_epoch(), owner, [&]{
+            return make_player_distances(owner);
+        });
+    }
+
+    bool game::is_possible_mth(player_ptr owner, card_ptr origin_card, bool is_response) {
+        return m_possible_mth_cache.get(state_epoch(), std::tuple{owner, origin_card, is_response}, [&]{
+            return check_possible_mth(owner, origin_card, is_response);
+        });
+    }
+    
     static player_list get_request_target_set_players(player_ptr origin) {
         if (origin) {
             if (auto req = origin->m_game->top_request<interface_target_set_players>(origin)) {
@@ -402,19 +410,19 @@ namespace banggame {
             .origin = req->origin,
             .target = req->target,
             .status_text = req->status_text(owner),
-            .respond_cards = generate_playable_cards_list(owner, true),
+            .respond_cards = get_playable_cards(owner, true),
             .highlight_cards = req->get_highlights(),
             .target_set_players = get_request_target_set_players(owner),
             .target_set_cards = get_request_target_set_cards(owner),
-            .distances = make_player_distances(owner),
+            .distances = get_player_distances(owner),
             .timer = get_request_timer_status(req->timer())
         };
     }
 
     status_ready_args game::make_status_ready_update(player_ptr owner) {
         return {
-            .play_cards = generate_playable_cards_list(owner),
-            .distances = make_player_distances(owner)
+            .play_cards = get_playable_cards(owner, false),
+            .distances = get_player_distances(owner)
         };
     }
 
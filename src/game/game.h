@@ -4,21 +4,51 @@
 #include "game_table.h"
 
 #include <generator>
+#include <optional>
+#include <map>
+#include <tuple>
 
 namespace banggame {
 
+    // values computed from the game state, kept until state_epoch() changes
+    template<typename Key, typename T>
+    class epoch_cache {
+    private:
+        struct entry {
+            std::optional<size_t> epoch;
+            T value;
+        };
+
+        std::map<Key, entry> m_entries;
+
+    public:
+        template<std::invocable Function>
+        const T &get(size_t epoch, const Key &key, Function &&fun) {
+            entry &value = m_entries[key];
+            if (value.epoch != epoch) {
+                value.value = std::invoke(fun);
+                value.epoch = epoch;
+            }
+            return value.value;
+        }
+    };
+
     struct game : game_table {
         using game_table::game_table;
         
-        std::generator<json::json> get_spectator_join_updates();
-        std::generator<json::json> get_game_log_updates(player_ptr target);
-        std::generator<json::json> get_rejoin_updates(player_ptr target);
+        std::generator<serialized_update> get_spectator_join_updates();
+        std::generator<serialized_update> get_game_log_updates(player_ptr target);
+        std::generator<serialized_update> get_rejoin_updates(player_ptr target);
 
         card_ptr add_card(const card_data &data);
         void add_players(std::span<int> user_ids);
         void start_game();
 
         player_distances make_player_distances(player_ptr p);
+
+        const playable_cards_list &get_playable_cards(player_ptr p, bool is_response);
+        const player_distances &get_player_distances(player_ptr p);
+        bool is_possible_mth(player_ptr p, card_ptr origin_card, bool is_response);
         request_status_args make_request_update(player_ptr p);
         status_ready_args make_status_ready_update(player_ptr p);
         player_order_update make_player_order_update(bool instant = false);
@@ -32,6 +62,11 @@ namespace banggame {
         void start_next_turn();
 
         void handle_player_death(player_ptr killer, player_ptr target, discard_all_reason reason);
+
+    private:
+        epoch_cache<std::pair<const_player_ptr, bool>, playable_cards_list> m_playable_cards_cache;
+        epoch_cache<const_player_ptr, player_distances> m_distances_cache;
+        epoch_cache<std::tuple<const_player_ptr, const_card_ptr, bool>, bool> m_possible_mth_cache;
     };
 
 }
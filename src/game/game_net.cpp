@@ -25,6 +25,13 @@ namespace json {
             }
             return card->id;
         }
+
+        void write(string_writer &out, Card card) const {
+            if (!card) {
+                throw serialize_error("Cannot serialize card: value is null");
+            }
+            out.write_number(card->id);
+        }
     };
 
     template<> struct deserializer<banggame::card_ptr, banggame::game_context> {
@@ -38,6 +45,17 @@ namespace json {
             }
             throw deserialize_error(std::format("Cannot find card {}", card_id));
         }
+
+        banggame::card_ptr read(string_reader &in, const banggame::game_context &context) const {
+            if (in.peek() != string_reader::value_kind::number) {
+                throw deserialize_error("Cannot deserialize card: value is not an integer");
+            }
+            int card_id = in.read_number<int>();
+            if (banggame::card_ptr card = context.find_card(card_id)) {
+                return card;
+            }
+            throw deserialize_error(std::format("Cannot find card {}", card_id));
+        }
     };
 
     template<maybe_const<banggame::player_ptr> Player, typename Context>
@@ -48,6 +66,13 @@ namespace json {
             }
             return player->id;
         }
+
+        void write(string_writer &out, Player player) const {
+            if (!player) {
+                throw serialize_error("Cannot serialize player: value is null");
+            }
+            out.write_number(player->id);
+        }
     };
 
     template<> struct deserializer<banggame::player_ptr, banggame::game_context> {
@@ -61,28 +86,69 @@ namespace json {
             }
             throw deserialize_error(std::format("Cannot find player {}", player_id));
         }
+
+        banggame::player_ptr read(string_reader &in, const banggame::game_context &context) const {
+            if (in.peek() != string_reader::value_kind::number) {
+                throw deserialize_error("Cannot deserialize player: value is not an integer");
+            }
+            int player_id = in.read_number<int>();
+            if (banggame::player_ptr player = context.find_player(player_id)) {
+                return player;
+            }
+            throw deserialize_error(std::format("Cannot find player {}", player_id));
+        }
     };
 
     template<typename Context> struct serializer<banggame::tag_map, Context> {
+        static short get_value(const banggame::tag_map &map, banggame::tag_type tag) {
+            for (const banggame::tag_value_pair &pair : map.values) {
+                if (pair.type == tag) {
+                    return pair.value;
+                }
+            }
+            return 0;
+        }
+
         json operator()(const banggame::tag_map &map) const {
             auto result = json::object();
-            for (const auto &[k, v] : map) {
-                result.push_back({enums::to_string(k), v});
+            for (banggame::tag_type tag : enums::enum_values<banggame::tag_type>()) {
+                if (map.types.check(tag)) {
+                    result.push_back({enums::to_string(tag), get_value(map, tag)});
+                }
             }
             return result;
         }
+
+        void write(string_writer &out, const banggame::tag_map &map) const {
+            out.begin_object();
+            for (banggame::tag_type tag : enums::enum_values<banggame::tag_type>()) {
+                if (map.types.check(tag)) {
+                    out.key(enums::to_string(tag));
+                    out.write_number(get_value(map, tag));
+                }
+            }
+            out.end_object();
+        }
     };
 
     template<typename Context> struct serializer<const banggame::effect_vtable *, Context> {
         json operator()(const banggame::effect_vtable *value) const {
             return value->name;
         }
+
+        void write(string_writer &out, const banggame::effect_vtable *value) const {
+            out.write_string(value->name);
+        }
     };
 
     template<typename Context> struct serializer<const banggame::equip_vtable *, Context> {
         json operator()(const banggame::equip_vtable *value) const {
             return value->name;
         }
+
+        void write(string_writer &out, const banggame::equip_vtable *value) const {
+            out.write_string(value->name);
+        }
     };
 
     template<typename Context> struct serializer<const banggame::modifier_vtable *, Context> {
@@ -93,6 +159,14 @@ namespace json {
                 return {};
             }
         }
+
+        void write(string_writer &out, const banggame::modifier_vtable *value) const {
+            if (value) {
+                out.write_string(value->name);
+            } else {
+                out.write_null();
+            }
+        }
     };
 
     template<typename Context> struct serializer<const banggame::mth_vtable *, Context> {
@@ -103,6 +177,24 @@ namespace json {
                 return {};
             }
         }
+
+        void write(string_writer &out, const banggame::mth_vtable *value) const {
+            if (value) {
+                out.write_string(value->name);
+            } else {
+                out.write_null();
+            }
+        }
+    };
+
+    template<typename Context> struct serializer<const banggame::card_data *, Context> {
+        json operator()(const banggame::card_data *value, const Context &ctx) const {
+            return serialize_unchecked(*value, ctx);
+        }
+
+        void write(string_writer &out, const banggame::card_data *value, const Context &ctx) const {
+            write_unchecked(out, *value, ctx);
+        }
     };
 
     template<typename Context> struct serializer<banggame::card_backface_list, Context> {
@@ -111,10 +203,18 @@ namespace json {
             banggame::card_deck_type deck;
         };
 
+        static auto backfaces(const banggame::card_backface_list &value) {
+            return value.cards | rv::transform([](banggame::const_card_ptr card) {
+                return card_backface{ card->id, card->data->deck };
+            });
+        }
+
         json operator()(const banggame::card_backface_list &value, const Context &ctx) const {
-            return serialize_unchecked(value.cards | rv::transform([](banggame::const_card_ptr card) {
-                return card_backface{ card->id, card->deck };
-            }), ctx);
+            return serialize_unchecked(backfaces(value), ctx);
+        }
+
+        void write(string_writer &out, const banggame::card_backface_list &value, const Context &ctx) const {
+            write_unchecked(out, backfaces(value), ctx);
         }
     };
 
@@ -124,11 +224,19 @@ namespace json {
             int user_id;
         };
 
-        json operator()(const banggame::player_user_list &value, const Context &ctx) const {
-            return serialize_unchecked(value.players | rv::transform([](banggame::const_player_ptr player) {
+        static auto player_users(const banggame::player_user_list &value) {
+            return value.players | rv::transform([](banggame::const_player_ptr player) {
                 return player_user_pair{ player->id, player->user_id };
-            }), ctx);
+            });
+        }
+
+        json operator()(const banggame::player_user_list &value, const Context &ctx) const {
+            return serialize_unchecked(player_users(value), ctx);
         };
+
+        void write(string_writer &out, const banggame::player_user_list &value, const Context &ctx) const {
+            write_unchecked(out, player_users(value), ctx);
+        }
     };
 
     struct game_string_tag {};
@@ -141,11 +249,20 @@ namespace json {
 
         json operator()(utils::nullable<banggame::const_card_ptr> value, const game_string_tag &ctx) const {
             if (value) {
-                return serialize_unchecked(format_card{ value->name, value->sign }, ctx);
+                return serialize_unchecked(format_card{ value->data->name, value->data->sign }, ctx);
             } else {
                 return json::object();
             }
         }
+
+        void write(string_writer &out, utils::nullable<banggame::const_card_ptr> value, const game_string_tag &ctx) const {
+            if (value) {
+                write_unchecked(out, format_card{ value->data->name, value->data->sign }, ctx);
+            } else {
+                out.begin_object();
+                out.end_object();
+            }
+        }
     };
 
     template<typename Context> struct serializer<banggame::game_string, Context> {
@@ -155,23 +272,50 @@ namespace json {
                 {"format_args", serialize_unchecked(value.format_args, game_string_tag{})}
             };
         }
+
+        void write(string_writer &out, const banggame::game_string &value) const {
+            out.begin_object();
+            out.key("format_str");
+            out.write_string(std::string_view(value.format_str));
+            out.key("format_args");
+            write_unchecked(out, value.format_args, game_string_tag{});
+            out.end_object();
+        }
     };
 
     template<> struct serializer<banggame::animation_duration, banggame::game_context> {
         json operator()(const banggame::animation_duration &duration, const banggame::game_context &context) const {
             return serialize_unchecked(context.transform_duration(duration.get()), context);
         }
+
+        void write(string_writer &out, const banggame::animation_duration &duration, const banggame::game_context &context) const {
+            write_unchecked(out, context.transform_duration(duration.get()), context);
+        }
     };
 
 }
 
 namespace banggame {
-    json::json game_net_manager::serialize_update(const game_update &update) const {
+    std::string game_net_manager::write_update(const game_update &update) const {
+        std::string result;
+        json::write<game_update, game_context>(result, update, *this);
+        return result;
+    }
+
+    json::json game_net_manager::serialize_update_tree(const game_update &update) const {
         return json::serialize<game_update, game_context>(update, *this);
     }
 
-    void game_net_manager::handle_game_action(player_ptr origin, const json::json &value) {
-        auto action = json::deserialize<game_action, game_context>(value, *this);
+    serialized_update game_net_manager::serialize_update(const game_update &update) const {
+        serialized_update result{ write_update(update) };
+        if (m_binary_updates) {
+            result.tree = serialize_update_tree(update);
+        }
+        return result;
+    }
+
+    void game_net_manager::handle_game_action(player_ptr origin, std::string_view value) {
+        auto action = json::read<game_action, game_context>(value, *this);
         auto result = verify_and_play(origin, action);
 
         utils::visit_tagged(overloaded{
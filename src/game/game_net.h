@@ -2,7 +2,9 @@
 #define __GAME_NET_H__
 
 #include <deque>
+#include <limits>
 #include <numeric>
+#include <string_view>
 
 #include "player.h"
 #include "game_update.h"
@@ -11,21 +13,24 @@
 
 namespace banggame {
 
+    // one bit for each player, indexed by player id
+    using player_mask = uint8_t;
+    static_assert(std::numeric_limits<player_mask>::digits >= lobby_max_players);
+
     class update_target {
     private:
-        const_player_ptr m_targets[lobby_max_players];
+        player_mask m_targets = 0;
+        bool m_inclusive:1;
+        bool m_invert_public:1;
 
-        struct {
-            bool m_inclusive:1;
-            bool m_invert_public:1;
-            int m_num_targets:6;
-        };
+        static player_mask player_bit(const_player_ptr target) {
+            return target ? player_mask(1 << player_index(target)) : 0;
+        }
 
         update_target(bool inclusive, bool invert_public, std::convertible_to<const_player_ptr> auto ... targets)
-            : m_targets{targets ...}
+            : m_targets{player_mask((0 | ... | player_bit(targets)))}
             , m_inclusive{inclusive}
             , m_invert_public{invert_public}
-            , m_num_targets{sizeof...(targets)}
         {
             static_assert(sizeof...(targets) <= lobby_max_players);
         }
@@ -33,11 +38,11 @@ namespace banggame {
         update_target(bool inclusive, std::convertible_to<const_player_ptr> auto ... targets)
             : update_target(inclusive, false, targets...) {}
 
-        auto targets() const {
-            return std::span{m_targets, m_targets + m_num_targets};
+    public:
+        static int player_index(const_player_ptr target) {
+            return target->id - 1;
         }
 
-    public:
         static update_target includes(std::convertible_to<const_player_ptr> auto ... targets) {
             return update_target(true, targets...);
         }
@@ -55,19 +60,25 @@ namespace banggame {
         }
 
         void add(player_ptr target) {
-            m_targets[m_num_targets++] = target;
+            m_targets |= player_bit(target);
         }
 
         bool matches(const_player_ptr target) const {
-            return rn::contains(targets(), target) == m_inclusive;
+            return bool(m_targets & player_bit(target)) == m_inclusive;
         }
 
-        bool matches(int user_id) const {
-            return rn::contains(targets(), user_id, &player::user_id) == m_inclusive;
+        // the players receiving this update, as a mask of player ids
+        player_mask player_recipients() const {
+            return m_inclusive ? m_targets : player_mask(~m_targets);
+        }
+
+        // users that aren't playing receive only updates that exclude some players
+        bool includes_spectators() const {
+            return !m_inclusive;
         }
 
         bool is_public() const {
-            return m_invert_public != m_inclusive != (m_num_targets == 0);
+            return m_invert_public != m_inclusive != (m_targets == 0);
         }
     };
 
@@ -78,9 +89,28 @@ namespace banggame {
         virtual game_duration transform_duration(game_duration duration) const = 0;
     };
 
+    // updates that are only sent to the clients, without any change in the game state
+    template<utils::fixed_string E>
+    constexpr bool is_state_update = [] {
+        constexpr std::string_view name = E;
+        for (std::string_view value : {
+            "game_error", "game_log", "game_prompt", "flash_card", "short_pause",
+            "request_status", "status_ready", "status_clear", "play_sound", "clear_logs"
+        }) {
+            if (name == value) return false;
+        }
+        return true;
+    }();
+
+    // an update written as json text. its tree is also kept while some recipient uses a binary wire format
+    struct serialized_update {
+        std::string text;
+        json::json tree;
+    };
+
     struct game_update_tuple {
         update_target target;
-        json::json content;
+        serialized_update content;
         game_duration duration;
     };
 
@@ -88,13 +118,26 @@ namespace banggame {
     protected:
         std::deque<game_update_tuple> m_updates;
         std::deque<std::pair<update_target, game_string>> m_saved_log;
+        size_t m_state_update_count = 0;
+        bool m_binary_updates = false;
+
+        // total duration of the pending updates seen by each player, kept as updates are added and drained
+        std::vector<std::pair<const_player_ptr, game_duration>> m_pending_durations;
 
     private:
-        json::json serialize_update(const game_update &update) const;
+        serialized_update serialize_update(const game_update &update) const;
+
+        void add_pending_duration(const update_target &target, game_duration duration) {
+            for (auto &[p, total] : m_pending_durations) {
+                if (target.matches(p)) {
+                    total += duration;
+                }
+            }
+        }
 
     protected:
         template<utils::fixed_string E> requires game_update_type<E>
-        json::json make_update(auto && ... args) {
+        serialized_update make_update(auto && ... args) {
             return serialize_update(game_update{utils::tag<E>{}, FWD(args) ... });
         }
     
@@ -106,16 +149,46 @@ namespace banggame {
         game_update_tuple get_next_update() {
             auto update = std::move(m_updates.front());
             m_updates.pop_front();
+            if (update.duration > game_duration{0}) {
+                add_pending_duration(update.target, -update.duration);
+            }
             return update;
         }
 
-        void handle_game_action(player_ptr origin, const json::json &value);
+        void set_binary_updates(bool value) {
+            m_binary_updates = value;
+        }
+
+        void add_update_recipient(const_player_ptr p) {
+            m_pending_durations.emplace_back(p, game_duration{0});
+        }
+
+        game_duration get_max_pending_duration() const {
+            game_duration result{0};
+            for (const auto &[p, total] : m_pending_durations) {
+                result = std::max(result, total);
+            }
+            return result;
+        }
+
+        void handle_game_action(player_ptr origin, std::string_view value);
+
+        // an update written straight as json text, and as a json tree which only the binary wire formats need
+        std::string write_update(const game_update &update) const;
+        json::json serialize_update_tree(const game_update &update) const;
+
+        size_t state_update_count() const {
+            return m_state_update_count;
+        }
 
     public:
         template<utils::fixed_string E> requires game_update_type<E>
         void add_update(update_target target, auto && ... args) {
             using value_type = utils::tagged_variant_value_type<game_update, utils::tag<E>>;
             game_duration duration{};
+            if constexpr (is_state_update<E>) {
+                ++m_state_update_count;
+            }
             if constexpr (std::is_void_v<value_type>) {
                 m_updates.emplace_back(target, serialize_update(game_update{utils::tag<E>{}}), duration);
             } else {
@@ -125,6 +198,9 @@ namespace banggame {
                 }
                 m_updates.emplace_back(target, serialize_update(game_update{utils::tag<E>{}, std::move(update)}), duration);
             }
+            if (duration > game_duration{0}) {
+                add_pending_duration(target, duration);
+            }
         }
 
         template<utils::fixed_string E> requires game_update_type<E>
@@ -11,6 +11,7 @@ namespace banggame {
 
     game_table::game_table(const game_options &options)
         : disabler_map{this}
+        , request_queue{&m_request_pool}
         , m_options{options}
     {
         std::random_device rd;
@@ -82,13 +83,48 @@ namespace banggame {
             return 1 + distance_mod;
         }
 
-        auto take_until_to = rv::take_while([=](const_player_ptr current) { return current != to; });
-        auto it = rn::find(m_players, from);
+        return get_seat_distances().distances[from->id - 1][to->id - 1] + distance_mod;
+    }
 
-        int count_cw = rn::count_if(rotate_range(m_players, it) | take_until_to, &player::alive);
-        int count_ccw = rn::count_if(rotate_range(m_players, rn::next(it)) | rv::reverse | take_until_to, &player::alive);
+    const game_table::seat_distance_table &game_table::get_seat_distances() const {
+        seat_distance_table &table = m_seat_distances;
+        size_t epoch = state_epoch();
+        if (table.epoch == epoch) {
+            return table;
+        }
+        table.epoch = epoch;
 
-        return std::min(count_cw, count_ccw) + distance_mod;
+        player_mask alive_players = 0;
+        for (const_player_ptr p : m_players) {
+            if (p->alive()) {
+                alive_players |= player_mask(1 << (p->id - 1));
+            }
+        }
+        if (alive_players == table.alive_players && table.players == m_players) {
+            return table;
+        }
+        table.alive_players = alive_players;
+        table.players = m_players;
+
+        // counts the alive players from the origin seat (included) to the target seat (excluded), in both directions
+        auto is_alive = [&](size_t index) {
+            return (alive_players & (1 << (m_players[index]->id - 1))) != 0;
+        };
+        size_t num_players = m_players.size();
+        for (size_t i = 0; i < num_players; ++i) {
+            for (size_t j = 0; j < num_players; ++j) {
+                int count_cw = 0;
+                for (size_t k = i; k != j; k = (k + 1) % num_players) {
+                    count_cw += is_alive(k);
+                }
+                int count_ccw = 0;
+                for (size_t k = i; k != j; k = (k + num_players - 1) % num_players) {
+                    count_ccw += is_alive(k);
+                }
+                table.distances[m_players[i]->id - 1][m_players[j]->id - 1] = int8_t(std::min(count_cw, count_ccw));
+            }
+        }
+        return table;
     }
 
     int game_table::num_alive() const {
@@ -101,11 +137,8 @@ namespace banggame {
             if (i == i2) continue;
 
             std::swap(vec[i], vec[i2]);
-            auto a = m_cards_storage.extract(vec[i]->id);
-            auto b = m_cards_storage.extract(vec[i2]->id);
-            std::swap(a->id, b->id);
-            m_cards_storage.insert(std::move(a));
-            m_cards_storage.insert(std::move(b));
+            std::swap(vec[i]->id, vec[i2]->id);
+            m_cards_storage.swap_slots(*vec[i], *vec[i2]);
         }
     }
 
@@ -3,6 +3,8 @@
 
 #include <span>
 #include <random>
+#include <array>
+#include <optional>
 
 #include "player.h"
 #include "game_net.h"
@@ -14,7 +16,7 @@
 
 namespace banggame {
 
-    struct game_table : game_net_manager, listener_map, disabler_map, request_queue {
+    struct game_table : request_pool, game_net_manager, listener_map, disabler_map, request_queue {
         const game_options &m_options;
         
         unsigned int rng_seed;
@@ -53,6 +55,23 @@ namespace banggame {
         player_ptr m_first_player = nullptr;
         player_ptr m_playing = nullptr;
 
+        size_t m_state_epoch = 0;
+
+    private:
+        // distances between seats without distance mods, indexed by player id.
+        // checked once per state epoch, rebuilt only when the order of the players or who is alive changes
+        struct seat_distance_table {
+            std::optional<size_t> epoch;
+            player_list players;
+            player_mask alive_players = 0;
+            std::array<std::array<int8_t, lobby_max_players>, lobby_max_players> distances{};
+        };
+
+        mutable seat_distance_table m_seat_distances;
+
+        const seat_distance_table &get_seat_distances() const;
+
+    public:
         game_table(const game_options &options);
 
         card_ptr find_card(int card_id) const override;
@@ -99,6 +118,16 @@ namespace banggame {
         bool check_flags(game_flag type) const;
 
         bool is_game_over() const override;
+
+        // changes whenever the game state might have changed: every state update, request, listener or disabler counts,
+        // as well as every played card. updates that only inform the clients, like request_status, don't
+        size_t state_epoch() const {
+            return m_state_epoch + state_update_count() + requests_version() + listeners_version() + disablers_version();
+        }
+
+        void bump_state_epoch() {
+            ++m_state_epoch;
+        }
     };
 
 }
@@ -59,7 +59,7 @@ namespace banggame {
 
     struct show_card_update {
         card_ptr card;
-        card_data info;
+        const card_data *info;
         animation_duration duration = durations.flip_card;
     };
 
@@ -7,8 +7,8 @@ namespace banggame {
     bool give_card(player_ptr target, std::string_view card_name) {
         auto all_cards = target->m_game->get_all_cards();
         auto card_it = rn::find_if(all_cards, [&](const_card_ptr target_card) {
-            if (string_equal_icase(card_name, target_card->name)) {
-                switch (target_card->deck) {
+            if (string_equal_icase(card_name, target_card->data->name)) {
+                switch (target_card->data->deck) {
                 case card_deck_type::train:
                 case card_deck_type::main_deck:
                     return target_card->pocket != pocket_type::player_hand || target_card->owner != target;
@@ -33,7 +33,7 @@ namespace banggame {
         
         target->m_game->send_request_status_clear();
         
-        switch (target_card->deck) {
+        switch (target_card->data->deck) {
         case card_deck_type::main_deck: {
             if (target_card->owner) {
                 target->steal_card(target_card);
@@ -9,28 +9,29 @@
 
 #include "game.h"
 
-#include <unordered_set>
+#include "utils/id_bitset.h"
 
 namespace banggame {
 
     static game_string check_duplicates(const effect_context &ctx) {
-        std::unordered_set<player_ptr> players;
+        utils::id_bitset<1> players;
         for (player_ptr p : ctx.selected_players) {
-            if (auto [it, inserted] = players.insert(p); !inserted) {
+            if (!players.insert(p->id)) {
                 return {"ERROR_DUPLICATE_PLAYER", p};
             }
         }
 
-        std::unordered_set<card_ptr> cards;
+        utils::id_bitset<> cards;
         for (card_ptr c : ctx.selected_cards) {
-            if (auto [it, inserted] = cards.insert(c); !inserted) {
+            if (!cards.insert(c->id)) {
                 return {"ERROR_DUPLICATE_CARD", c};
             }
         }
 
-        std::unordered_map<card_ptr, int> cubes;
+        // only a few cubes can be selected, each card is counted the first time it's seen
+        utils::id_bitset<> cube_cards;
         for (card_ptr c : ctx.selected_cubes.all_cubes()) {
-            if (++cubes[c] > c->num_cubes) {
+            if (cube_cards.insert(c->id) && rn::count(ctx.selected_cubes.all_cubes(), c) > c->num_cubes) {
                 return {"ERROR_NOT_ENOUGH_CUBES_ON", c};
             }
         }
@@ -190,7 +191,7 @@ namespace banggame {
                 return "ERROR_INVALID_EQUIP_TARGET";
             }
         } else {
-            MAYBE_RETURN(check_player_filter(origin_card, origin, origin_card->equip_target, target));
+            MAYBE_RETURN(check_player_filter(origin_card, origin, origin_card->data->equip_target, target));
         }
         if (card_ptr equipped = target->find_equipped_card(origin_card)) {
             return {"ERROR_DUPLICATED_CARD", equipped};
@@ -223,7 +224,7 @@ namespace banggame {
     }
 
     prompt_string get_equip_prompt(player_ptr origin, card_ptr origin_card, player_ptr target) {
-        for (const equip_holder &holder : origin_card->equips) {
+        for (const equip_holder &holder : origin_card->data->equips) {
             MAYBE_RETURN(holder.on_prompt(origin_card, origin, target));
         }
         return {};
@@ -421,6 +422,7 @@ namespace banggame {
         }
 
         origin->m_game->send_request_status_clear();
+        origin->m_game->bump_state_epoch();
 
         if (args.card->pocket != pocket_type::button_row) {
             origin->m_played_cards.push_back(make_played_card_history(args, is_response, ctx));
@@ -440,6 +442,7 @@ namespace banggame {
             apply_target_list(origin, args.card, is_response, args.targets, ctx);
         }
 
+        origin->m_game->bump_state_epoch();
         return {};
     }
 }
\ No newline at end of file
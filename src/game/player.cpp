@@ -15,6 +15,8 @@
 #include "effects/base/predraw_check.h"
 #include "effects/base/requests.h"
 
+#include "net/logging.h"
+
 #include <cassert>
 #include <numeric>
 
@@ -45,7 +47,7 @@ namespace banggame {
 
     void player::enable_equip(card_ptr target_card) {
         bool card_disabled = m_game->is_disabled(target_card);
-        for (const equip_holder &holder : target_card->equips) {
+        for (const equip_holder &holder : target_card->data->equips) {
             if (!card_disabled || holder.is_nodisable()) {
                 holder.on_enable(target_card, this);
             }
@@ -54,7 +56,7 @@ namespace banggame {
 
     void player::disable_equip(card_ptr target_card) {
         bool card_disabled = m_game->is_disabled(target_card);
-        for (const equip_holder &holder : target_card->equips | rv::reverse) {
+        for (const equip_holder &holder : target_card->data->equips | rv::reverse) {
             if (!card_disabled || holder.is_nodisable()) {
                 holder.on_disable(target_card, this);
             }
@@ -69,16 +71,37 @@ namespace banggame {
         return first_character()->get_tag_value(tag_type::initial_cards).value_or(m_hp);
     }
 
+    template<std::invocable Function>
+    int player::get_cached_stat(player_stat stat, Function &&fun) const {
+        cached_stat &cached = m_cached_stats[enums::indexof(stat)];
+        size_t epoch = m_game->state_epoch();
+        if (cached.epoch != epoch) {
+            cached.value = std::invoke(fun);
+            cached.epoch = epoch;
+        }
+#ifndef NDEBUG
+        else if (int value = std::invoke(fun); value != cached.value) {
+            logging::error("Cached {} of player {} is {}, expected {}", enums::to_string(stat), id, cached.value, value);
+            cached.value = value;
+        }
+#endif
+        return cached.value;
+    }
+
     int player::max_cards_end_of_turn() const {
-        int ncards = m_hp;
-        m_game->call_event(event_type::apply_maxcards_modifier{ this, ncards });
-        return ncards;
+        return get_cached_stat(player_stat::max_cards_end_of_turn, [&]{
+            int ncards = m_hp;
+            m_game->call_event(event_type::apply_maxcards_modifier{ this, ncards });
+            return ncards;
+        });
     }
 
     int player::get_num_checks() const {
-        int nchecks = 1;
-        m_game->call_event(event_type::count_num_checks{ this, nchecks });
-        return nchecks;
+        return get_cached_stat(player_stat::num_checks, [&]{
+            int nchecks = 1;
+            m_game->call_event(event_type::count_num_checks{ this, nchecks });
+            return nchecks;
+        });
     }
 
     int player::get_bangs_played() const {
@@ -88,21 +111,27 @@ namespace banggame {
     }
 
     int player::get_range_mod() const {
-        int mod = 0;
-        m_game->call_event(event_type::count_range_mod{ this, range_mod_type::range_mod, mod });
-        return mod;
+        return get_cached_stat(player_stat::range_mod, [&]{
+            int mod = 0;
+            m_game->call_event(event_type::count_range_mod{ this, range_mod_type::range_mod, mod });
+            return mod;
+        });
     }
 
     int player::get_weapon_range() const {
-        int range = 1;
-        m_game->call_event(event_type::count_range_mod{ this, range_mod_type::weapon_range, range });
-        return range;
+        return get_cached_stat(player_stat::weapon_range, [&]{
+            int range = 1;
+            m_game->call_event(event_type::count_range_mod{ this, range_mod_type::weapon_range, range });
+            return range;
+        });
     }
 
     int player::get_distance_mod() const {
-        int mod = 0;
-        m_game->call_event(event_type::count_range_mod{ this, range_mod_type::distance_mod, mod });
-        return mod;
+        return get_cached_stat(player_stat::distance_mod, [&]{
+            int mod = 0;
+            m_game->call_event(event_type::count_range_mod{ this, range_mod_type::distance_mod, mod });
+            return mod;
+        });
     }
 
     player_ptr player::get_next_player() const {
@@ -142,7 +171,7 @@ namespace banggame {
     }
 
     card_ptr player::find_equipped_card(const_card_ptr card) const {
-        auto it = rn::find(m_table, card->name, &card::name);
+        auto it = rn::find(m_table, card->data->name, &card::get_name);
         if (it != m_table.end()) {
             return *it;
         } else {
@@ -237,7 +266,7 @@ namespace banggame {
     }
 
     void player::add_to_hand(card_ptr target) {
-        if (target->deck == card_deck_type::train) {
+        if (target->data->deck == card_deck_type::train) {
             equip_card(target);
         } else {
             target->move_to(pocket_type::player_hand, this, m_game->check_flags(game_flag::hands_shown)
@@ -1,10 +1,21 @@
 #ifndef __PLAYER_H__
 #define __PLAYER_H__
 
+#include <array>
+#include <optional>
+
 #include "card.h"
 
 namespace banggame {
 
+    enum class player_stat : uint8_t {
+        max_cards_end_of_turn,
+        num_checks,
+        range_mod,
+        weapon_range,
+        distance_mod,
+    };
+
     struct player {
         game *m_game;
         int id;
@@ -34,6 +45,20 @@ namespace banggame {
 
         int8_t m_gold = 0;
 
+    private:
+        struct cached_stat {
+            std::optional<size_t> epoch;
+            int value;
+        };
+
+        // values computed through call_event, kept until the state epoch of the game changes.
+        // builds without NDEBUG recompute them anyway and log any mismatch
+        mutable std::array<cached_stat, enums::enum_values<player_stat>().size()> m_cached_stats;
+
+        template<std::invocable Function>
+        int get_cached_stat(player_stat stat, Function &&fun) const;
+
+    public:
         player(game *game, int id, int user_id)
             : m_game(game), id(id), user_id(user_id) {}
 
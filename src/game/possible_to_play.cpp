@@ -2,38 +2,57 @@
 
 namespace banggame {
 
-    static bool is_possible_mth(player_ptr origin, card_ptr origin_card, const mth_holder &mth, const effect_list &effects, const effect_context &ctx, target_list &targets) {
-        if (targets.size() == mth.args.size()) {
-            return !mth_holder{
-                mth.type,
-                small_int_set(small_int_set_sized_tag, targets.size())
-            }.get_error(origin_card, origin, targets, ctx);
+    using mth_candidates = std::vector<play_card_target>;
+
+    static bool find_mth_targets(player_ptr origin, card_ptr origin_card, const mth_holder &mth, std::span<const mth_candidates> candidates, target_list &targets) {
+        if (targets.size() == candidates.size()) {
+            return !mth.get_error(origin_card, origin, targets, {});
+        }
+        for (const play_card_target &target : candidates[targets.size()]) {
+            targets.push_back(target);
+            bool result = find_mth_targets(origin, origin_card, mth, candidates, targets);
+            targets.pop_back();
+            if (result) return true;
         }
-        const auto &effect = effects.at(mth.args[targets.size()]);
-        if (effect.target == TARGET_TYPE(player)) {
-            for (player_ptr target : get_all_player_targets(origin, origin_card, effect, ctx)) {
-                targets.emplace_back(utils::tag<"player">{}, target);
-                bool result = is_possible_mth(origin, origin_card, mth, effects, ctx, targets);
-                targets.pop_back();
-                if (result) return true;
+        return false;
+    }
+
+    bool check_possible_mth(player_ptr origin, card_ptr origin_card, bool is_response) {
+        const auto &mth = origin_card->get_mth(is_response);
+        const auto &effects = origin_card->get_effect_list(is_response);
+
+        // the targets of each argument don't depend on the other ones,
+        // so they are filtered once instead of once for every partial combination
+        std::vector<mth_candidates> candidates;
+        candidates.reserve(mth.args.size());
+        for (int arg : mth.args) {
+            const auto &effect = effects.at(arg);
+            mth_candidates &values = candidates.emplace_back();
+            if (effect.target == TARGET_TYPE(player)) {
+                for (player_ptr target : get_all_player_targets(origin, origin_card, effect)) {
+                    values.emplace_back(utils::tag<"player">{}, target);
+                }
+            } else if (effect.target == TARGET_TYPE(card)) {
+                for (card_ptr target : get_all_card_targets(origin, origin_card, effect)) {
+                    values.emplace_back(utils::tag<"card">{}, target);
+                }
+            } else {
+                // ignore other target types
+                return true;
             }
-            return false;
-        } else if (effect.target == TARGET_TYPE(card)) {
-            for (card_ptr target : get_all_card_targets(origin, origin_card, effect, ctx)) {
-                targets.emplace_back(utils::tag<"card">{}, target);
-                bool result = is_possible_mth(origin, origin_card, mth, effects, ctx, targets);
-                targets.pop_back();
-                if (result) return true;
+            if (values.empty()) {
+                return false;
             }
-            return false;
-        } else {
-            // ignore other target types
-            return true;
         }
+
+        mth_holder sized_mth{ mth.type, small_int_set(small_int_set_sized_tag, candidates.size()) };
+        target_list targets;
+        targets.reserve(candidates.size());
+        return find_mth_targets(origin, origin_card, sized_mth, candidates, targets);
     }
 
     static auto map_cards_playable_with_modifiers(
-        player_ptr origin, const card_list &modifiers, bool is_response, const effect_context &ctx,
+        player_ptr origin, std::span<const card_ptr> modifiers, bool is_response, const effect_context &ctx,
         auto function
     ) {
         auto map = [&](rn::forward_range auto &&range) {
@@ -53,7 +72,7 @@ namespace banggame {
         }
     }
 
-    bool is_possible_to_play(player_ptr origin, card_ptr origin_card, bool is_response, const card_list &modifiers, const effect_context &ctx) {
+    bool is_possible_to_play(player_ptr origin, card_ptr origin_card, bool is_response, std::span<const card_ptr> modifiers, const effect_context &ctx) {
         for (card_ptr mod_card : modifiers) {
             if (mod_card == origin_card) return false;
             if (mod_card->get_modifier(is_response).get_error(mod_card, origin, origin_card, ctx)) return false;
@@ -76,16 +95,15 @@ namespace banggame {
                 return false;
             }
 
-            if (const auto &mth = origin_card->get_mth(is_response)) {
-                target_list targets;
-                targets.reserve(mth.args.size());
-                if (!is_possible_mth(origin, origin_card, mth, effects, {}, targets)) {
-                    return false;
-                }
+            if (origin_card->get_mth(is_response) && !origin->m_game->is_possible_mth(origin, origin_card, is_response)) {
+                return false;
             }
 
             if (const modifier_holder &modifier = origin_card->get_modifier(is_response)) {
-                auto modifiers_copy = modifiers;
+                utils::small_vector<card_ptr, max_modifiers> modifiers_copy;
+                for (card_ptr mod_card : modifiers) {
+                    modifiers_copy.push_back(mod_card);
+                }
                 modifiers_copy.push_back(origin_card);
                 auto ctx_copy = ctx;
                 modifier.add_context(origin_card, origin, ctx_copy);
@@ -1,6 +1,8 @@
 #ifndef __POSSIBLE_TO_PLAY_H__
 #define __POSSIBLE_TO_PLAY_H__
 
+#include <span>
+
 #include "game.h"
 
 #include "filters.h"
@@ -10,7 +12,9 @@
 
 namespace banggame {
     
-    bool is_possible_to_play(player_ptr origin, card_ptr origin_card, bool is_response = false, const card_list &modifiers = {}, const effect_context &ctx = {});
+    bool check_possible_mth(player_ptr origin, card_ptr origin_card, bool is_response);
+
+    bool is_possible_to_play(player_ptr origin, card_ptr origin_card, bool is_response = false, std::span<const card_ptr> modifiers = {}, const effect_context &ctx = {});
 
     playable_cards_list generate_playable_cards_list(player_ptr origin, bool is_response = false);
     
@@ -1,6 +1,7 @@
 #ifndef __REQUEST_BASE_H__
 #define __REQUEST_BASE_H__
 
+#include <atomic>
 #include <memory>
 
 #include "cards/game_string.h"
@@ -11,6 +12,9 @@ namespace banggame {
     class request_queue;
     class request_base;
 
+    struct interface_target_set_players;
+    struct interface_target_set_cards;
+
     static constexpr ticks max_timer_duration = 10s;
     
     using timer_id_t = size_t;
@@ -22,7 +26,7 @@ namespace banggame {
 
     private:
         timer_id_t timer_id;
-        static inline timer_id_t timer_id_counter = 0;
+        static inline std::atomic<timer_id_t> timer_id_counter = 0;
 
         ticks lifetime{};
 
@@ -53,6 +57,10 @@ namespace banggame {
             return lifetime <= ticks{0};
         }
 
+        ticks remaining() const {
+            return lifetime;
+        }
+
         virtual void on_finished() {}
     };
 
@@ -76,6 +84,13 @@ namespace banggame {
 
         virtual game_string status_text(player_ptr owner) const { return {}; };
         virtual card_list get_highlights() const { return {}; }
+
+    private:
+        friend class request_queue;
+
+        // set by request_queue when the request is queued, so that top_request can return them without a dynamic_cast
+        interface_target_set_players *m_target_set_players = nullptr;
+        interface_target_set_cards *m_target_set_cards = nullptr;
     };
 
     struct interface_target_set_players {
@@ -9,6 +9,9 @@
 namespace banggame {
 
     request_state request_queue::invoke_update() {
+        // the top request can change anything in on_update()
+        ++m_version;
+
         if (is_game_over()) {
             return utils::tag<"done">{};
         } else if (auto req = top_request()) {
@@ -77,6 +80,27 @@ namespace banggame {
         }
     }
 
+    std::optional<ticks> request_queue::next_deadline() {
+        if (is_game_over()) {
+            return std::nullopt;
+        }
+
+        std::optional<ticks> result = utils::visit_tagged(overloaded{
+            [](auto) -> std::optional<ticks> { return std::nullopt; },
+            [](utils::tag<"waiting">, ticks timer) -> std::optional<ticks> { return timer + ticks{1}; },
+            [](utils::tag<"bot_play">, ticks timer) -> std::optional<ticks> { return timer + ticks{1}; }
+        }, m_state);
+
+        if (auto req = top_request()) {
+            if (auto *timer = req->timer()) {
+                ticks remaining = std::max(timer->remaining(), ticks{1});
+                result = result ? std::min(*result, remaining) : remaining;
+            }
+        }
+
+        return result;
+    }
+
     static constexpr ticks max_update_timer_duration = 10s;
     static constexpr int max_update_count = 30;
     
@@ -4,6 +4,8 @@
 #include <memory>
 #include <concepts>
 #include <functional>
+#include <optional>
+#include <memory_resource>
 
 #include "cards/card_effect.h"
 
@@ -43,10 +45,18 @@ namespace banggame {
 
     using request_state_index = utils::tagged_variant_index<request_state>;
 
+    // the memory of the requests of a game: listeners can keep requests alive,
+    // so the game has this as its first base class to destroy it last
+    struct request_pool {
+        std::pmr::unsynchronized_pool_resource m_request_pool;
+    };
+
     class request_queue {
     private:
+        std::pmr::memory_resource *m_resource;
         utils::stable_priority_queue<std::shared_ptr<request_base>, request_priority_ordering> m_requests;
         request_state m_state;
+        size_t m_version = 0;
 
         request_state invoke_update();
         request_state invoke_tick_update();
@@ -60,9 +70,15 @@ namespace banggame {
         virtual request_state request_bot_play(bool instant) = 0;
 
     public:
+        explicit request_queue(std::pmr::memory_resource *resource)
+            : m_resource{resource} {}
+
         void tick();
         void commit_updates();
 
+        // number of calls to tick() before the state can change, or nothing if ticking has no effect
+        std::optional<ticks> next_deadline();
+
     public:
         bool pending_requests() const {
             return !m_requests.empty();
@@ -72,24 +88,53 @@ namespace banggame {
             return holds_alternative<"waiting">(m_state);
         }
 
+        size_t requests_version() const {
+            return m_version;
+        }
+
         template<typename T = request_base>
         std::shared_ptr<T> top_request(const_player_ptr target = nullptr) {
             if (!m_requests.empty()) {
-                auto req = m_requests.top();
+                const auto &req = m_requests.top();
                 if (!target || req->target == target) {
-                    return std::dynamic_pointer_cast<T>(req);
+                    if constexpr (std::is_same_v<T, request_base>) {
+                        return req;
+                    } else if constexpr (std::is_same_v<T, interface_target_set_players>) {
+                        if (req->m_target_set_players) {
+                            return std::shared_ptr<T>(req, req->m_target_set_players);
+                        }
+                    } else if constexpr (std::is_same_v<T, interface_target_set_cards>) {
+                        if (req->m_target_set_cards) {
+                            return std::shared_ptr<T>(req, req->m_target_set_cards);
+                        }
+                    } else {
+                        return std::dynamic_pointer_cast<T>(req);
+                    }
                 }
             }
             return nullptr;
         }
 
-        void queue_request(std::shared_ptr<request_base> &&value) {
+        template<std::derived_from<request_base> T>
+        std::shared_ptr<T> make_request(auto && ... args) {
+            return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>{m_resource}, FWD(args) ... );
+        }
+
+        template<std::derived_from<request_base> T>
+        void queue_request(std::shared_ptr<T> &&value) {
+            if constexpr (std::derived_from<T, interface_target_set_players>) {
+                value->m_target_set_players = value.get();
+            }
+            if constexpr (std::derived_from<T, interface_target_set_cards>) {
+                value->m_target_set_cards = value.get();
+            }
             m_requests.emplace(std::move(value));
+            ++m_version;
         }
 
         template<std::derived_from<request_base> T>
         void queue_request(auto && ... args) {
-            queue_request(std::make_shared<T>(FWD(args) ... ));
+            queue_request(make_request<T>(FWD(args) ... ));
         }
 
         template<template<typename ... Ts> typename Template>
@@ -106,6 +151,7 @@ namespace banggame {
 
         void pop_request() {
             m_requests.pop();
+            ++m_version;
         }
     };
 
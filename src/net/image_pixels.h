@@ -92,6 +92,18 @@ namespace json {
             }
             return banggame::image_from_png_data_url(value.get<std::string_view>());
         }
+
+        banggame::image_pixels read(string_reader &in) const {
+            switch (in.peek()) {
+            case string_reader::value_kind::null:
+                in.read_null();
+                return {};
+            case string_reader::value_kind::string:
+                return banggame::image_from_png_data_url(in.read_string_view());
+            default:
+                throw deserialize_error("Cannot deserialize image_pixels");
+            }
+        }
     };
 }
 
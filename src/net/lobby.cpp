@@ -26,7 +26,7 @@ namespace banggame {
             .propic = session->propic,
             .flags = flags,
             .lifetime = (!is_disconnected() && session->client.expired())
-                ? std::chrono::duration_cast<std::chrono::milliseconds>(session->lifetime)
+                ? std::max(std::chrono::duration_cast<std::chrono::milliseconds>(session->expire_time - std::chrono::steady_clock::now()), 0ms)
                 : 0ms
         };
     }
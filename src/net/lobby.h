@@ -13,6 +13,13 @@ class game_manager;
 struct game_lobby;
 
 using client_handle = std::weak_ptr<void>;
+using shared_message = std::shared_ptr<const std::string>;
+
+struct outgoing_message {
+    client_handle client;
+    shared_message data;
+    wire_format format;
+};
 
 struct lobby_error : std::runtime_error {
     using std::runtime_error::runtime_error;
@@ -29,14 +36,20 @@ static constexpr ticks client_accept_timer = 30s;
 static constexpr ticks ping_interval = 10s;
 static constexpr auto pings_until_disconnect = 2min / ping_interval;
 
+static constexpr ticks max_idle_time = 1min;
+
 struct game_session {
+    id_type session_id;
     std::string username;
     image_registry::registered_image propic;
     
     game_lobby *lobby = nullptr;
 
     client_handle client;
-    ticks lifetime = user_lifetime;
+    wire_format format = wire_format::json;
+
+    // set when the client disconnects, the session is removed at this time unless it reconnects
+    std::chrono::steady_clock::time_point expire_time;
 
     void set_username(std::string new_username);
     void set_propic(image_pixels new_propic);
@@ -45,15 +58,12 @@ struct game_session {
 using session_ptr = std::shared_ptr<game_session>;
 
 namespace connection_state {
-    struct not_validated {
-        ticks timeout = ticks{0};
-    };
+    struct not_validated {};
     
     struct connected {
         connected(session_ptr session): session{session} {}
 
         session_ptr session;
-        ticks ping_timer = ticks{0};
         int ping_count = 0;
     };
 
@@ -120,14 +130,28 @@ struct game_lobby {
     std::vector<lobby_chat_args> chat_messages;
     
     lobby_state state;
-    ticks lifetime = lobby_lifetime;
+
+    // set when the last user leaves, the lobby is removed at this time unless someone joins
+    std::chrono::steady_clock::time_point expire_time;
 
     std::unique_ptr<banggame::game> m_game;
+    std::vector<outgoing_message> outgoing_messages;
+    size_t outgoing_serialized_bytes = 0;
+
+    bool is_playing() const {
+        return state == lobby_state::playing && m_game;
+    }
 
     auto connected_users(this auto &&self) {
         return rv::remove_if(std::forward_like<decltype(self)>(self.users), &game_user::is_disconnected);
     }
 
+    bool has_binary_users() const {
+        return rn::any_of(connected_users(), [](const game_user &user) {
+            return user.session->format != wire_format::json;
+        });
+    }
+
     std::pair<game_user &, bool> add_user(session_ptr session);
 
     game_user &find_user(session_ptr session);
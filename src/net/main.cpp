@@ -35,6 +35,7 @@ int main(int argc, char **argv) {
     options.add_options()
         ("port",        "",                 cxxopts::value(port))
         ("cheats",      "Enable Cheats",    cxxopts::value(server.options().enable_cheats))
+        ("w,workers",   "Game Worker Threads", cxxopts::value(server.options().num_workers))
         ("l,logging",   "Logging Level",    cxxopts::value(logging::log_function::global_level))
         ("r,reuse-addr","Reuse Address",    cxxopts::value(reuse_addr))
         ("t,tracking-db","Tracking Database File", cxxopts::value(tracking_file))
@@ -75,14 +76,18 @@ int main(int argc, char **argv) {
     server.init();
 #endif
 
+    server.start_workers();
+
     std::jthread main_loop{[&](std::stop_token stop) {
         try {
-            auto next_tick = std::chrono::steady_clock::now() + banggame::ticks64{0};
+            auto last_tick = std::chrono::steady_clock::now() + banggame::ticks64{0};
 
+            // instead of polling every tick, sleep until the next timer expires or a message arrives
             while (!stop.stop_requested()) {
-                next_tick += banggame::ticks64{1};
-                server.tick();
-                std::this_thread::sleep_until(next_tick);
+                auto elapsed = std::chrono::floor<banggame::ticks64>(std::chrono::steady_clock::now() - last_tick);
+                last_tick += elapsed;
+                server.tick(std::chrono::duration_cast<banggame::ticks>(elapsed));
+                server.wait_for_messages(stop, std::chrono::ceil<std::chrono::steady_clock::duration>(last_tick + server.next_deadline()));
             }
         } catch (const std::exception &error) {
             std::println(stderr, "Unhandled exception: {}", error.what());
@@ -3,11 +3,12 @@
 #include "bot_info.h"
 #include "tracking.h"
 
+#include <bit>
+
 using namespace banggame;
 
-void game_manager::on_message(client_handle client, std::string_view msg) {
+void game_manager::on_message(client_handle client, client_message client_msg) {
     try {
-        auto client_msg = deserialize_message(json::json::parse(msg));
         utils::visit_tagged([&](utils::tag_for<client_message> auto tag, auto && ... args) {
             auto it = m_connections.find(client);
             if (it == m_connections.end()) {
@@ -21,9 +22,9 @@ void game_manager::on_message(client_handle client, std::string_view msg) {
             } else {
                 throw critical_error("CLIENT_NOT_VALIDATED");
             }
-        }, client_msg);
+        }, std::move(client_msg));
     } catch (const json::json_error &e) {
-        logging::warn("Invalid message: {:.{}}\n{}", msg, net::max_message_log_size, e.what());
+        logging::warn("Invalid message: {}", e.what());
         kick_client(client, "INVALID_MESSAGE");
     } catch (const critical_error &e) {
         kick_client(client, e.what());
@@ -39,89 +40,178 @@ game_manager::game_manager() {
     session_rng.seed(rd());
 }
 
+void game_manager::start_workers() {
+    if (m_options.num_workers > 1) {
+        m_workers.start(m_options.num_workers);
+        logging::status("Started {} game workers", m_options.num_workers);
+    }
+}
+
 void game_manager::stop() {
     for (const auto &[client, con] : m_connections) {
         kick_client(client, "SERVER_STOP");
     }
+
+    logging::status("Serialized {} bytes, sent {} bytes", stats().bytes_serialized, stats().bytes_sent);
     
     net::wsserver::stop();
 }
 
-void game_manager::tick() {
+void game_manager::tick(ticks elapsed) {
+    // all ticks but the last one passed while idle, they're applied before handling the new messages
+    // so that a timer started by a message never sees time from before it was created
+    if (elapsed > ticks{1}) {
+        advance_time(elapsed - ticks{1});
+    }
+
     net::wsserver::tick();
 
-    for (auto &[client, con] : m_connections) {
-        std::visit(overloaded{
-            [&](connection_state::not_validated &value) {
-                if (++value.timeout > client_accept_timer) {
-                    kick_client(client, "HANDSHAKE_FAIL");
-                }
-            },
-            [&](connection_state::connected &value) {
-                if (++value.ping_timer > ping_interval) {
-                    value.ping_timer = ticks{};
-                    if (++value.ping_count >= pings_until_disconnect) {
-                        kick_client(client, "INACTIVITY");
-                    } else {
-                        send_message<"ping">(client);
-                    }
-                }
-            },
-            [](connection_state::invalid) {}
-        }, con);
+    advance_time(std::min(elapsed, ticks{1}));
+
+    flush_messages();
+}
+
+void game_manager::advance_time(ticks elapsed) {
+    m_timers.advance(elapsed.count(), [&](server_timer_event &&event) {
+        std::visit([&](const auto &value) { handle_timer(value); }, event);
+    });
+
+    tick_games(elapsed);
+}
+
+ticks game_manager::next_deadline() {
+    ticks result = max_idle_time;
+
+    if (auto expiry = m_timers.next_expiry()) {
+        result = ticks(std::min<uint64_t>(*expiry, result.count()));
     }
 
-    if (std::erase_if(m_sessions, [&](auto &pair) {
-        session_ptr session = pair.second;
-        if (session->client.expired()) {
-            if (--session->lifetime <= ticks{0}) {
-                if (session->lobby) {
-                    kick_user_from_lobby(session);
-                }
-                return true;
+    for (game_lobby &lobby : m_lobbies | rv::values | rv::filter(&game_lobby::is_playing)) {
+        if (auto deadline = lobby.m_game->next_deadline()) {
+            result = std::min(result, *deadline);
+        }
+    }
+
+    return std::max(result, ticks{1});
+}
+
+void game_manager::handle_timer(const server_timer::handshake_timeout &value) {
+    if (auto it = m_connections.find(value.client); it != m_connections.end()) {
+        if (std::holds_alternative<connection_state::not_validated>(it->second)) {
+            kick_client(value.client, "HANDSHAKE_FAIL");
+        }
+    }
+}
+
+void game_manager::handle_timer(const server_timer::ping &value) {
+    if (auto it = m_connections.find(value.client); it != m_connections.end()) {
+        if (auto *con = std::get_if<connection_state::connected>(&it->second)) {
+            if (++con->ping_count >= pings_until_disconnect) {
+                kick_client(value.client, "INACTIVITY");
+            } else {
+                send_message<"ping">(value.client);
+                schedule_timer(ping_interval + ticks{1}, server_timer::ping{ value.client });
             }
-        } else {
-            session->lifetime = user_lifetime;
         }
-        return false;
-    })) {
-        tracking::track_user_count(m_sessions.size());
     }
+}
+
+void game_manager::handle_timer(const server_timer::session_expired &value) {
+    if (auto it = m_sessions.find(value.session_id); it != m_sessions.end()) {
+        session_ptr session = it->second;
+        if (session->client.expired() && session->expire_time == value.expire_time) {
+            if (session->lobby) {
+                kick_user_from_lobby(session);
+            }
+            m_sessions.erase(it);
+            tracking::track_user_count(m_sessions.size());
+        }
+    }
+}
 
-    if (std::erase_if(m_lobbies, [&](auto &pair) {
-        game_lobby &lobby = pair.second;
-        if (lobby.state == lobby_state::playing && lobby.m_game) {
-            try {
+void game_manager::handle_timer(const server_timer::lobby_expired &value) {
+    if (auto it = m_lobbies.find(value.lobby_id); it != m_lobbies.end()) {
+        game_lobby &lobby = it->second;
+        if (lobby.connected_users().empty() && lobby.expire_time == value.expire_time) {
+            broadcast_message_no_lobby<"lobby_removed">(lobby.lobby_id);
+            m_lobbies.erase(it);
+            tracking::track_lobby_count(m_lobbies.size());
+        }
+    }
+}
+
+void game_manager::tick_games(ticks elapsed) {
+    auto playing_lobbies = m_lobbies | rv::values | rv::filter(&game_lobby::is_playing);
+
+    // lobbies share no game state, each one is always stepped by the same worker
+    m_workers.for_each_sharded(playing_lobbies, [elapsed](game_lobby &lobby) {
+        try {
+            lobby.m_game->set_binary_updates(lobby.has_binary_users());
+
+            for (ticks i{}; i < elapsed && lobby.m_game->next_deadline(); ++i) {
                 lobby.m_game->tick();
-                
-                while (lobby.m_game->pending_updates()) {
-                    auto [target, update, update_time] = lobby.m_game->get_next_update();
-                    for (const game_user &user : lobby.connected_users()) {
-                        if (target.matches(user.user_id)) {
-                            send_message<"game_update">(user.session->client, update);
-                        }
-                    }
+            }
+            
+            if (!lobby.m_game->pending_updates()) {
+                return;
+            }
+
+            // connected users are resolved to player indices once, then each update is a scan of its recipient mask
+            std::array<const game_user *, lobby_max_players> player_users{};
+            std::vector<const game_user *> spectator_users;
+            for (const game_user &user : lobby.connected_users()) {
+                if (player_ptr p = lobby.m_game->find_player_by_userid(user.user_id)) {
+                    player_users[update_target::player_index(p)] = &user;
+                } else {
+                    spectator_users.push_back(&user);
                 }
+            }
+
+            while (lobby.m_game->pending_updates()) {
+                auto [target, update, update_time] = lobby.m_game->get_next_update();
 
-                if (lobby.m_game->is_game_over()) {
-                    lobby.state = lobby_state::finished;
-                    broadcast_message_no_lobby<"lobby_update">(lobby);
+                // every recipient of an update shares the same frame, serialized only if someone receives it
+                std::optional<message_frames> frames;
+                auto send_update = [&](const game_user &user) {
+                    if (!frames) {
+                        frames.emplace(make_game_update_frames(update));
+                    }
+                    wire_format format = user.session->format;
+                    lobby.outgoing_messages.push_back({ user.session->client, frames->get(format), format });
+                };
+
+                for (player_mask mask = target.player_recipients(); mask != 0; mask &= mask - 1) {
+                    if (const game_user *user = player_users[std::countr_zero(mask)]) {
+                        send_update(*user);
+                    }
+                }
+                if (target.includes_spectators()) {
+                    for (const game_user *user : spectator_users) {
+                        send_update(*user);
+                    }
+                }
+                if (frames) {
+                    lobby.outgoing_serialized_bytes += frames->serialized_bytes();
                 }
-            } catch (const std::exception &e) {
-                logging::warn("Error in tick(): {}", e.what());
             }
+        } catch (const std::exception &e) {
+            logging::warn("Error in tick(): {}", e.what());
         }
-        if (lobby.connected_users().empty()) {
-            if (--lobby.lifetime <= ticks{0}) {
-                broadcast_message_no_lobby<"lobby_removed">(lobby.lobby_id);
-                return true;
-            }
-        } else {
-            lobby.lifetime = lobby_lifetime;
+    }, &game_lobby::lobby_id);
+
+    for (game_lobby &lobby : playing_lobbies) {
+        for (outgoing_message &message : lobby.outgoing_messages) {
+            push_frame(message.client, message.format, std::move(message.data));
+        }
+        lobby.outgoing_messages.clear();
+
+        count_serialized(lobby.outgoing_serialized_bytes);
+        lobby.outgoing_serialized_bytes = 0;
+
+        if (lobby.m_game->is_game_over()) {
+            lobby.state = lobby_state::finished;
+            broadcast_message_no_lobby<"lobby_update">(lobby);
         }
-        return false;
-    })) {
-        tracking::track_lobby_count(m_lobbies.size());
     }
 }
 
@@ -150,6 +240,7 @@ void game_manager::handle_message(utils::tag<"connect">, client_handle client, c
     session_ptr &session = it->second;
     if (inserted) {
         session = std::make_shared<game_session>();
+        session->session_id = session_id;
         tracking::track_user_count(m_sessions.size());
     } else {
         kick_client(session->client, "RECONNECT_WITH_SAME_SESSION_ID");
@@ -158,8 +249,14 @@ void game_manager::handle_message(utils::tag<"connect">, client_handle client, c
     session->set_username(std::move(args.username));
     session->set_propic(std::move(args.propic));
     session->client = client;
+    session->format = args.format.value_or(wire_format::json);
     
     con.emplace<connection_state::connected>(session);
+    set_client_options(client, {
+        .format = session->format,
+        .combine_messages = args.combine_messages.value_or(false)
+    });
+    schedule_timer(ping_interval + ticks{1}, server_timer::ping{ client });
     
     send_message<"client_accepted">(client, session_id);
     for (const auto &[id, lobby] : m_lobbies) {
@@ -285,16 +382,18 @@ void game_manager::handle_join_lobby(session_ptr session, game_lobby &lobby) {
         }
         send_message<"game_started">(session->client);
 
+        lobby.m_game->set_binary_updates(lobby.has_binary_users());
+
         for (const auto &msg : lobby.m_game->get_spectator_join_updates()) {
-            send_message<"game_update">(session->client, msg);
+            send_game_update(session->client, msg);
         }
         if (target) {
             for (const auto &msg : lobby.m_game->get_rejoin_updates(target)) {
-                send_message<"game_update">(session->client, msg);
+                send_game_update(session->client, msg);
             }
         }
         for (const auto &msg : lobby.m_game->get_game_log_updates(target)) {
-            send_message<"game_update">(session->client, msg);
+            send_game_update(session->client, msg);
         }
     }
 
@@ -349,6 +448,11 @@ void game_manager::kick_user_from_lobby(session_ptr session) {
         }
     }
 
+    if (lobby.connected_users().empty()) {
+        lobby.expire_time = std::chrono::steady_clock::now() + lobby_lifetime;
+        schedule_timer(lobby_lifetime, server_timer::lobby_expired{ lobby.lobby_id, lobby.expire_time });
+    }
+
     broadcast_message_no_lobby<"lobby_update">(lobby);
 
     session->lobby = nullptr;
@@ -365,6 +469,7 @@ void game_manager::kick_user_from_lobby(session_ptr session) {
 
 void game_manager::on_connect(client_handle client) {
     m_connections.emplace(client, connection_state::not_validated{});
+    schedule_timer(client_accept_timer + ticks{1}, server_timer::handshake_timeout{ client });
     tracking::track_client_count(m_connections.size());
 }
 
@@ -375,6 +480,8 @@ void game_manager::invalidate_connection(client_handle client) {
             session_ptr session = connected->session;
 
             session->client.reset();
+            session->expire_time = std::chrono::steady_clock::now() + user_lifetime;
+            schedule_timer(user_lifetime, server_timer::session_expired{ session->session_id, session->expire_time });
             if (game_lobby *lobby = session->lobby) {
                 game_user &user = lobby->find_user(session);
                 broadcast_message_lobby<"lobby_user_update">(*lobby, user);
@@ -390,6 +497,15 @@ void game_manager::kick_client(client_handle client, std::string message, int co
     net::wsserver::kick_client(client, std::move(message), code);
 }
 
+wire_format game_manager::get_client_format(client_handle client) const {
+    if (auto it = m_connections.find(client); it != m_connections.end()) {
+        if (auto *value = std::get_if<connection_state::connected>(&it->second)) {
+            return value->session->format;
+        }
+    }
+    return wire_format::json;
+}
+
 void game_manager::on_disconnect(client_handle client) {
     invalidate_connection(client);
     m_connections.erase(client);
@@ -557,6 +673,7 @@ void game_manager::handle_message(utils::tag<"game_start">, session_ptr session)
     broadcast_message_lobby<"game_started">(lobby);
 
     lobby.m_game = std::make_unique<banggame::game>(lobby.options);
+    lobby.m_game->set_binary_updates(lobby.has_binary_users());
 
     logging::info("Started game {} with seed {}", lobby.name, lobby.m_game->rng_seed);
 
@@ -615,19 +732,20 @@ void game_manager::handle_message(utils::tag<"game_rejoin">, session_ptr session
     remove_user_flag(lobby, user, game_user_flag::spectator);
     target->user_id = user.user_id;
 
+    lobby.m_game->set_binary_updates(lobby.has_binary_users());
     lobby.m_game->add_update<"player_add">(target);
     
     for (const auto &msg : lobby.m_game->get_rejoin_updates(target)) {
-        send_message<"game_update">(session->client, msg);
+        send_game_update(session->client, msg);
     }
     for (const auto &msg : lobby.m_game->get_game_log_updates(target)) {
-        send_message<"game_update">(session->client, msg);
+        send_game_update(session->client, msg);
     }
 
     broadcast_message_no_lobby<"lobby_update">(lobby);
 }
 
-void game_manager::handle_message(utils::tag<"game_action">, session_ptr session, const json::json &value) {
+void game_manager::handle_message(utils::tag<"game_action">, session_ptr session, const json::raw_json &value) {
     if (!session->lobby) {
         throw lobby_error("ERROR_PLAYER_NOT_IN_LOBBY");
     }
@@ -647,5 +765,5 @@ void game_manager::handle_message(utils::tag<"game_action">, session_ptr session
         throw lobby_error("ERROR_USER_NOT_CONTROLLING_PLAYER");
     }
 
-    lobby.m_game->handle_game_action(origin, value);
+    lobby.m_game->handle_game_action(origin, value.value);
 }
\ No newline at end of file
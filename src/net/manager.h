@@ -6,27 +6,107 @@
 #include "wsserver.h"
 #include "logging.h"
 
+#include "utils/worker_pool.h"
+#include "utils/timing_wheel.h"
+
+#include <functional>
 #include <random>
 
 namespace banggame {
 
+// a server message written once as json text, then encoded lazily for each other wire format it's sent with.
+// binary formats are encoded from the tree given by make_value, which is only called if someone needs it
+class message_frames {
+public:
+    message_frames(std::string json_text, std::move_only_function<json::json()> make_value)
+        : m_make_value{std::move(make_value)}
+    {
+        m_serialized_bytes = json_text.size();
+        m_frames[enums::indexof(wire_format::json)] = std::make_shared<const std::string>(std::move(json_text));
+    }
+
+    const shared_message &get(wire_format format) {
+        shared_message &frame = m_frames[enums::indexof(format)];
+        if (!frame) {
+            if (m_value.is_null()) {
+                m_value = m_make_value();
+            }
+            frame = std::make_shared<const std::string>(encode_message(m_value, format));
+            m_serialized_bytes += frame->size();
+        }
+        return frame;
+    }
+
+    size_t serialized_bytes() const {
+        return m_serialized_bytes;
+    }
+
+private:
+    std::move_only_function<json::json()> m_make_value;
+    json::json m_value;
+    std::array<shared_message, enums::enum_values<wire_format>().size()> m_frames;
+    size_t m_serialized_bytes = 0;
+};
+
 template<utils::fixed_string E> requires server_message_type<E>
-std::string make_message(auto && ... args) {
-    return serialize_message(server_message{utils::tag<E>{}, FWD(args) ...})
-        .dump(-1, ' ', true, nlohmann::json::error_handler_t::replace);
+message_frames make_message_frames(auto && ... args) {
+    server_message message{utils::tag<E>{}, FWD(args) ...};
+    std::string json_text = write_message(message);
+    return message_frames{std::move(json_text), [message = std::move(message)]{
+        return serialize_message(message);
+    }};
+}
+
+// the update must outlive the frames
+inline message_frames make_game_update_frames(const serialized_update &update) {
+    return message_frames{write_game_update_message(update.text), [&update]{
+        // the tree is only kept while some user of the lobby uses a binary format
+        json::json value = update.tree.is_null() ? json::json::parse(update.text) : update.tree;
+        return serialize_message(server_message{utils::tag<"game_update">{}, std::move(value)});
+    }};
+}
+
+namespace server_timer {
+    struct handshake_timeout {
+        client_handle client;
+    };
+
+    struct ping {
+        client_handle client;
+    };
+
+    struct session_expired {
+        id_type session_id;
+        std::chrono::steady_clock::time_point expire_time;
+    };
+
+    struct lobby_expired {
+        id_type lobby_id;
+        std::chrono::steady_clock::time_point expire_time;
+    };
 }
 
+using server_timer_event = std::variant<
+    server_timer::handshake_timeout,
+    server_timer::ping,
+    server_timer::session_expired,
+    server_timer::lobby_expired
+>;
+
 struct server_options {
     bool enable_cheats = false;
     int max_session_id_count = 10;
+    int num_workers = std::thread::hardware_concurrency();
 };
 
 class game_manager: public net::wsserver {
 public:
     game_manager();
 
+    void start_workers();
     void stop();
-    void tick();
+    void tick(ticks elapsed);
+    ticks next_deadline();
     void kick_client(client_handle client, std::string message, int code = kick_opcode);
 
     server_options &options() { return m_options; }
@@ -34,32 +114,65 @@ public:
 protected:
     void on_connect(client_handle client) override;
     void on_disconnect(client_handle client) override;
-    void on_message(client_handle client, std::string_view message) override;
+    void on_message(client_handle client, client_message message) override;
 
 private:
+    void push_frame(client_handle client, wire_format format, shared_message data) {
+        push_message(client, { std::move(data), format != wire_format::json });
+    }
+
+    void send_frames(client_handle client, message_frames &frames) {
+        wire_format format = get_client_format(client);
+        push_frame(client, format, frames.get(format));
+        count_serialized(frames.serialized_bytes());
+    }
+
     template<utils::fixed_string E> requires server_message_type<E>
     void send_message(client_handle client, auto && ... args) {
-        push_message(client, make_message<E>(FWD(args) ... ));
+        message_frames frames = make_message_frames<E>(FWD(args) ... );
+        send_frames(client, frames);
+    }
+
+    void send_game_update(client_handle client, const serialized_update &update) {
+        message_frames frames = make_game_update_frames(update);
+        send_frames(client, frames);
     }
 
     template<utils::fixed_string E> requires server_message_type<E>
     void broadcast_message_no_lobby(auto && ... args) {
-        std::string message = make_message<E>(FWD(args) ... );
+        message_frames frames = make_message_frames<E>(FWD(args) ... );
         for (session_ptr session : m_sessions | rv::values) {
             if (!session->lobby) {
-                push_message(session->client, message);
+                push_frame(session->client, session->format, frames.get(session->format));
             }
         }
+        count_serialized(frames.serialized_bytes());
     }
 
     template<utils::fixed_string E> requires server_message_type<E>
     void broadcast_message_lobby(const game_lobby &lobby, auto && ... args) {
-        std::string message = make_message<E>(FWD(args) ... );
+        message_frames frames = make_message_frames<E>(FWD(args) ... );
         for (const game_user &user : lobby.connected_users()) {
-            push_message(user.session->client, message);
+            push_frame(user.session->client, user.session->format, frames.get(user.session->format));
         }
+        count_serialized(frames.serialized_bytes());
+    }
+
+    wire_format get_client_format(client_handle client) const;
+
+    void advance_time(ticks elapsed);
+    void tick_games(ticks elapsed);
+
+    void schedule_timer(ticks delay, server_timer_event event) {
+        m_timers.schedule(delay.count(), std::move(event));
     }
 
+    // timers are never cancelled, each handler checks whether its timer is still relevant
+    void handle_timer(const server_timer::handshake_timeout &value);
+    void handle_timer(const server_timer::ping &value);
+    void handle_timer(const server_timer::session_expired &value);
+    void handle_timer(const server_timer::lobby_expired &value);
+
     void invalidate_connection(client_handle client);
     void kick_user_from_lobby(session_ptr session);
     void add_lobby_chat_message(game_lobby &lobby, game_user *is_read_for, lobby_chat_args message);
@@ -82,7 +195,7 @@ private:
     void handle_message(utils::tag<"user_spectate">,  session_ptr session, bool spectator);
     void handle_message(utils::tag<"game_start">,     session_ptr session);
     void handle_message(utils::tag<"game_rejoin">,    session_ptr session, const game_rejoin_args &value);
-    void handle_message(utils::tag<"game_action">,    session_ptr session, const json::json &value);
+    void handle_message(utils::tag<"game_action">,    session_ptr session, const json::raw_json &value);
 
     void handle_chat_command(session_ptr session, const std::string &command);
 
@@ -106,8 +219,12 @@ private:
     lobby_map m_lobbies;
     client_map m_connections;
 
+    utils::timing_wheel<server_timer_event> m_timers;
+
     server_options m_options;
 
+    utils::worker_pool m_workers;
+
     friend class chat_command;
 };
 
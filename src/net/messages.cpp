@@ -7,12 +7,62 @@
 
 namespace banggame {
     
+    client_message deserialize_message(const json::json &value) {
+        return json::deserialize<client_message>(value);
+    }
+
+    client_message read_message(std::string_view message) {
+        return json::read<client_message>(message);
+    }
+
     json::json serialize_message(const server_message &message) {
         return json::serialize(message);
     }
 
-    client_message deserialize_message(const json::json &value) {
-        return json::deserialize<client_message>(value);
+    std::string write_message(const server_message &message) {
+        std::string result;
+        json::write(result, message);
+        return result;
+    }
+
+    // game updates are already written by the game, only the envelope is added here
+    std::string write_game_update_message(std::string_view update) {
+        std::string result;
+        json::string_writer out{result};
+        out.begin_object();
+        out.key("game_update");
+        out.write_raw(update);
+        out.end_object();
+        return result;
+    }
+
+    std::string encode_message(const json::json &value, wire_format format) {
+        std::string result;
+        switch (format) {
+        case wire_format::json:
+            return value.dump(-1, ' ', true, json::json::error_handler_t::replace);
+        case wire_format::msgpack:
+            json::json::to_msgpack(value, result);
+            return result;
+        case wire_format::cbor:
+            json::json::to_cbor(value, result);
+            return result;
+        default:
+            throw std::runtime_error("invalid wire format");
+        }
+    }
+
+    json::json decode_message(std::string_view data, wire_format format) {
+        switch (format) {
+        case wire_format::json:
+            return json::json::parse(data);
+        case wire_format::msgpack:
+            return json::json::from_msgpack(data);
+        case wire_format::cbor:
+            return json::json::from_cbor(data);
+        default:
+            throw std::runtime_error("invalid wire format");
+        }
     }
 
 }
\ No newline at end of file
@@ -12,10 +12,18 @@ namespace banggame {
     
     using id_type = unsigned int;
 
+    enum class wire_format {
+        json,
+        msgpack,
+        cbor,
+    };
+
     struct connect_args {
         std::string username;
         image_pixels propic;
         id_type session_id;
+        std::optional<wire_format> format;
+        std::optional<bool> combine_messages;
     };
 
     struct lobby_make_args {
@@ -51,10 +59,18 @@ namespace banggame {
         utils::tag<"user_spectate", bool>,
         utils::tag<"game_start">,
         utils::tag<"game_rejoin", game_rejoin_args>,
-        utils::tag<"game_action", json::json>
+        utils::tag<"game_action", json::raw_json>
     >;
 
     client_message deserialize_message(const json::json &value);
+    client_message read_message(std::string_view message);
+
+    json::json serialize_message(const server_message &message);
+    std::string write_message(const server_message &message);
+    std::string write_game_update_message(std::string_view update);
+
+    std::string encode_message(const json::json &value, wire_format format);
+    json::json decode_message(std::string_view data, wire_format format);
 
     enum class lobby_state {
         waiting,
@@ -144,7 +160,6 @@ namespace banggame {
     template<utils::fixed_string Name>
     concept server_message_type = utils::tag_for<utils::tag<Name>, server_message>;
     
-    json::json serialize_message(const server_message &message);
 
 }
 
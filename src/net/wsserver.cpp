@@ -56,6 +56,12 @@ namespace net {
     struct wsclient_data {
         std::shared_ptr<void *> client;
         std::string address;
+
+        // only changed by flush_messages, after the game thread has accepted the connect
+        wsserver::client_options options;
+
+        // set once the connect is queued, the game thread only needs the disconnect after that
+        bool queued = false;
     };
 
     template<bool SSL>
@@ -78,17 +84,55 @@ namespace net {
                 .open = [this](auto *ws) {
                     wsclient_data *data = ws->getUserData();
                     logging::status("[{}] Connected", data->address = ws->getRemoteAddressAsText());
-                    m_message_queue.emplace(data->client = std::make_shared<void *>(ws), connected{});
+                    data->client = std::make_shared<void *>(ws);
+
+                    // the new client needs a free cell for its own disconnect too
+                    if (push_inbound(data->client, connected{}, m_open_clients + 1)) {
+                        data->queued = true;
+                        ++m_open_clients;
+                    } else {
+                        logging::warn("[{}] Inbound queue full, closing connection", data->address);
+                        ws->end(kick_opcode, "SERVER_BUSY");
+                    }
                 },
                 .message = [this](auto *ws, std::string_view message, uWS::OpCode opCode) {
                     wsclient_data *data = ws->getUserData();
-                    logging::info("[{}] ==> {:.{}}", data->address, message, max_message_log_size);
-                    m_message_queue.emplace(data->client, std::string(message));
+                    bool binary = opCode == uWS::BINARY;
+                    if (binary) {
+                        logging::info("[{}] ==> ({} bytes)", data->address, message.size());
+                    } else {
+                        logging::info("[{}] ==> {:.{}}", data->address, message, max_message_log_size);
+                    }
+
+                    // messages are parsed here so that the game thread only ever sees valid ones
+                    banggame::client_message client_msg;
+                    try {
+                        client_msg = binary
+                            ? banggame::deserialize_message(banggame::decode_message(message, data->options.format))
+                            : banggame::read_message(message);
+                    } catch (const json::json_error &e) {
+                        logging::warn("[{}] Invalid message: {}", data->address, e.what());
+                        ws->end(kick_opcode, "INVALID_MESSAGE");
+                        return;
+                    }
+
+                    // the message can't be dropped without the client missing it, so the client is closed instead
+                    if (!push_inbound(data->client, std::move(client_msg), m_open_clients)) {
+                        logging::warn("[{}] Inbound queue full, closing connection", data->address);
+                        ws->end(kick_opcode, "SERVER_BUSY");
+                    }
                 },
                 .close = [this](auto *ws, int code, std::string_view message) {
                     wsclient_data *data = ws->getUserData();
                     logging::status("[{}] Disconnected (code={} message={})", data->address, code, message);
-                    m_message_queue.emplace(data->client, disconnected{});
+                    if (data->queued) {
+                        data->queued = false;
+                        --m_open_clients;
+                        // a cell was kept free for it since the connect
+                        if (!push_inbound(data->client, disconnected{}, 0)) {
+                            logging::error("[{}] Inbound queue full, disconnect was dropped", data->address);
+                        }
+                    }
                 }
             })
             .get("/.env", [this](auto *res, auto *req) {
@@ -136,6 +180,7 @@ namespace net {
     }
 
     void wsserver::stop() {
+        flush_messages();
         visit_server([&]<bool SSL>(uWS::TemplatedApp<SSL> &server) {
             logging::status("Stopping server...");
             server.getLoop()->defer([&]{
@@ -144,38 +189,117 @@ namespace net {
         }, m_server);
     }
 
+    bool wsserver::push_inbound(client_handle client, message_type message, size_t reserve) {
+        if (!m_message_queue.try_push({std::move(client), std::move(message)}, reserve)) {
+            return false;
+        }
+        if (!m_wakeup_pending.exchange(true)) {
+            std::scoped_lock lock{m_wakeup_mutex};
+            m_wakeup_cv.notify_one();
+        }
+        return true;
+    }
+
+    void wsserver::wait_for_messages(std::stop_token stop, std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock lock{m_wakeup_mutex};
+        m_wakeup_cv.wait_until(lock, stop, deadline, [&]{ return m_wakeup_pending.load(); });
+
+        // cleared before the next drain, so a message pushed after it always wakes up the following wait
+        m_wakeup_pending = false;
+    }
+
     void wsserver::tick() {
-        while (auto elem = m_message_queue.pop()) {
-            const auto &[client, message] = *elem;
+        auto handle_message = [&](inbound_message &&elem) {
+            auto &[client, message] = elem;
 
             std::visit(overloaded {
-                [&](std::string_view str) { on_message(client, str); },
+                [&](banggame::client_message &client_msg) { on_message(client, std::move(client_msg)); },
                 [&](connected) { on_connect(client); },
                 [&](disconnected) { on_disconnect(client); }
             }, message);
+        };
+
+        m_message_queue.drain(handle_message);
+    }
+
+    void wsserver::push_message(client_handle client, outbound_frame frame) {
+        auto &batch = m_outbound[client];
+        if (!batch.kick) {
+            m_stats.bytes_sent += frame.data->size();
+            batch.messages.push_back(std::move(frame));
         }
     }
 
-    void wsserver::push_message(client_handle client, std::string message) {
-        visit_server([&]<bool SSL>(uWS::TemplatedApp<SSL> &server) {
-            server.getLoop()->defer([client, message = std::move(message)]{
-                if (auto *ws = websocket_cast<SSL>(client)) {
-                    auto *data = ws->getUserData();
-                    logging::info("[{}] <== {:.{}}", data->address, message, max_message_log_size);
-                    ws->send(message, uWS::TEXT);
+    void wsserver::kick_client(client_handle client, std::string message, int code) {
+        auto &batch = m_outbound[client];
+        if (!batch.kick) {
+            batch.kick.emplace(code, std::move(message));
+        }
+    }
+
+    void wsserver::set_client_options(client_handle client, client_options options) {
+        m_outbound[client].options = options;
+    }
+
+    template<bool SSL>
+    static void send_frame(uWS::WebSocket<SSL, true, wsclient_data> *ws, const wsserver::outbound_frame &frame) {
+        auto *data = ws->getUserData();
+        if (frame.binary) {
+            logging::info("[{}] <== ({} bytes)", data->address, frame.data->size());
+            ws->send(*frame.data, uWS::BINARY);
+        } else {
+            logging::info("[{}] <== {:.{}}", data->address, *frame.data, max_message_log_size);
+            ws->send(*frame.data, uWS::TEXT);
+        }
+    }
+
+    template<bool SSL>
+    static void send_batch(uWS::WebSocket<SSL, true, wsclient_data> *ws, const std::vector<wsserver::outbound_frame> &messages) {
+        auto *data = ws->getUserData();
+        // only text frames can be joined into a json array
+        if (data->options.combine_messages && messages.size() > 1 && rn::none_of(messages, &wsserver::outbound_frame::binary)) {
+            std::string frame = "[";
+            for (const auto &message : messages) {
+                logging::info("[{}] <== {:.{}}", data->address, *message.data, max_message_log_size);
+                if (frame.size() > 1) {
+                    frame.push_back(',');
                 }
-            });
-        }, m_server);
+                frame.append(*message.data);
+            }
+            frame.push_back(']');
+            ws->send(frame, uWS::TEXT);
+        } else {
+            for (const auto &message : messages) {
+                send_frame(ws, message);
+            }
+        }
     }
 
-    void wsserver::kick_client(client_handle client, std::string message, int code) {
+    void wsserver::flush_messages() {
+        if (m_outbound.empty()) return;
+
         visit_server([&]<bool SSL>(uWS::TemplatedApp<SSL> &server) {
-            server.getLoop()->defer([client, code, message = std::move(message)]{
-                if (auto *ws = websocket_cast<SSL>(client)) {
-                    ws->end(code, message);
+            server.getLoop()->defer([outbound = std::move(m_outbound)]{
+                for (const auto &[client, batch] : outbound) {
+                    if (auto *ws = websocket_cast<SSL>(client)) {
+                        if (batch.options) {
+                            ws->getUserData()->options = *batch.options;
+                        }
+                        if (!batch.messages.empty()) {
+                            ws->cork([&]{
+                                send_batch(ws, batch.messages);
+                            });
+                        }
+                        if (batch.kick) {
+                            const auto &[code, message] = *batch.kick;
+                            ws->end(code, message);
+                        }
+                    }
                 }
             });
         }, m_server);
+
+        m_outbound.clear();
     }
 
 }
\ No newline at end of file
@@ -1,13 +1,26 @@
 #ifndef __WSSERVER_H__
 #define __WSSERVER_H__
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <variant>
+#include <vector>
 
-#include "utils/tsqueue.h"
+#include "messages.h"
+
+#include "utils/mpsc_queue.h"
 
 namespace net {
 
     static constexpr size_t max_message_log_size = 1000;
+    static constexpr size_t inbound_queue_capacity = 8192;
 
     class wsserver_impl;
 
@@ -19,6 +32,25 @@ namespace net {
     public:
         using client_handle = std::weak_ptr<void>;
 
+        // an already serialized frame, shared between every client it is sent to
+        using shared_message = std::shared_ptr<const std::string>;
+
+        struct outbound_frame {
+            shared_message data;
+            bool binary = false;
+        };
+
+        struct outbound_stats {
+            size_t bytes_serialized = 0;
+            size_t bytes_sent = 0;
+        };
+
+        // what a client negotiated at connect, only known once the game thread accepts it
+        struct client_options {
+            banggame::wire_format format = banggame::wire_format::json;
+            bool combine_messages = false;
+        };
+
         static constexpr int kick_opcode = 1000;
 
     private:
@@ -26,13 +58,45 @@ namespace net {
 
         struct connected {};
         struct disconnected {};
-        using message_type = std::variant<std::string, connected, disconnected>;
-        utils::tsqueue<std::pair<client_handle, message_type>> m_message_queue;
+        using message_type = std::variant<banggame::client_message, connected, disconnected>;
+        using inbound_message = std::pair<client_handle, message_type>;
+        utils::mpsc_queue<inbound_message> m_message_queue{inbound_queue_capacity};
+
+        // clients whose connect was queued and whose disconnect wasn't yet, only used by the network thread.
+        // that many cells of the ring are kept free, so that a disconnect is never dropped
+        size_t m_open_clients = 0;
+
+        std::mutex m_wakeup_mutex;
+        std::condition_variable_any m_wakeup_cv;
+        std::atomic<bool> m_wakeup_pending = false;
+
+        bool push_inbound(client_handle client, message_type message, size_t reserve);
+
+        struct outbound_batch {
+            std::optional<client_options> options;
+            std::vector<outbound_frame> messages;
+            std::optional<std::pair<int, std::string>> kick;
+        };
+        using outbound_map = std::map<client_handle, outbound_batch, std::owner_less<>>;
+        outbound_map m_outbound;
+        outbound_stats m_stats;
 
     protected:
         virtual void on_connect(client_handle handle) = 0;
         virtual void on_disconnect(client_handle handle) = 0;
-        virtual void on_message(client_handle hdl, std::string_view message) = 0;
+        virtual void on_message(client_handle hdl, banggame::client_message message) = 0;
+
+        void flush_messages();
+
+        shared_message share_message(std::string message) {
+            m_stats.bytes_serialized += message.size();
+            return std::make_shared<const std::string>(std::move(message));
+        }
+
+        // for messages not created through share_message
+        void count_serialized(size_t bytes) {
+            m_stats.bytes_serialized += bytes;
+        }
 
     public:
         virtual ~wsserver() = default;
@@ -48,9 +112,21 @@ namespace net {
 
         void tick();
 
-        void push_message(client_handle client, std::string message);
+        // blocks the game thread until a message is received, the deadline is reached or a stop is requested
+        void wait_for_messages(std::stop_token stop, std::chrono::steady_clock::time_point deadline);
+
+        void push_message(client_handle client, outbound_frame frame);
+
+        void push_message(client_handle client, std::string message) {
+            push_message(client, { share_message(std::move(message)) });
+        }
+
+        const outbound_stats &stats() const { return m_stats; }
 
         void kick_client(client_handle client, std::string message, int code = kick_opcode);
+
+        // applied on the network thread by the next flush, before the messages queued with it are sent
+        void set_client_options(client_handle client, client_options options);
     };
 
 }
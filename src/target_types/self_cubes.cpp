@@ -18,7 +18,7 @@ namespace banggame {
 
     template<> void visit_cubes::add_context(effect_context &ctx) {
         ctx.selected_cubes.insert(origin_card,
-            card_list{static_cast<size_t>(effect.target_value), origin_card},
+            rv::repeat_n(origin_card, effect.target_value),
             effect.target_value);
     }
 
@@ -78,6 +78,16 @@ namespace json {
             }
             return ret;
         }
+
+        void write(string_writer &out, const enums::bitset<T> &value) const {
+            out.begin_array();
+            for (T v : enums::enum_values<T>()) {
+                if (value.check(v)) {
+                    out.write_string(enums::to_string(v));
+                }
+            }
+            out.end_array();
+        }
     };
 
     template<enums::enumeral T, typename Context>
@@ -92,6 +102,18 @@ namespace json {
             }
             return ret;
         }
+
+        enums::bitset<T> read(string_reader &in, const Context &ctx) const {
+            if (in.peek() != string_reader::value_kind::array) {
+                throw deserialize_error(std::format("Cannot deserialize {} bitset: value is not an array", reflect::type_name<T>()));
+            }
+            enums::bitset<T> ret;
+            in.begin_array();
+            while (in.next_element()) {
+                ret.add(read_unchecked<T>(in, ctx));
+            }
+            return ret;
+        }
     };
 
 }
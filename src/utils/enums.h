@@ -92,6 +92,18 @@ namespace json {
                 throw deserialize_error(std::format("Invalid {} value: {}", reflect::type_name<T>(), str));
             }
         }
+
+        T read(string_reader &in) const {
+            if (in.peek() != string_reader::value_kind::string) {
+                throw deserialize_error(std::format("Cannot deserialize {}: value is not a string", reflect::type_name<T>()));
+            }
+            std::string_view str = in.read_string_view();
+            if (auto ret = enums::from_string<T>(str)) {
+                return *ret;
+            } else {
+                throw deserialize_error(std::format("Invalid {} value: {}", reflect::type_name<T>(), str));
+            }
+        }
     };
 
     template<enums::enumeral T, typename Context>
@@ -99,6 +111,10 @@ namespace json {
         json operator()(const T &value) const {
             return enums::to_string(value);
         }
+
+        void write(string_writer &out, const T &value) const {
+            out.write_string(enums::to_string(value));
+        }
     };
 
 }
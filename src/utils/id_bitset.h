@@ -0,0 +1,85 @@
+#ifndef __ID_BITSET_H__
+#define __ID_BITSET_H__
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace utils {
+
+    // set of dense ids, like the ones given out by id_map.
+    // ids below InlineWords * 64 are stored in place, only larger ones allocate
+    template<size_t InlineWords = 16>
+    class id_bitset {
+    private:
+        using word_type = uint64_t;
+        static constexpr size_t word_bits = 64;
+
+        std::array<word_type, InlineWords> m_inline{};
+        std::vector<word_type> m_overflow;
+
+        static constexpr word_type to_bit(size_t id) {
+            return word_type{1} << (id % word_bits);
+        }
+
+        const word_type *find_word(size_t id) const {
+            size_t index = id / word_bits;
+            if (index < InlineWords) {
+                return &m_inline[index];
+            }
+            index -= InlineWords;
+            if (index < m_overflow.size()) {
+                return &m_overflow[index];
+            }
+            return nullptr;
+        }
+
+        word_type &get_word(size_t id) {
+            size_t index = id / word_bits;
+            if (index < InlineWords) {
+                return m_inline[index];
+            }
+            index -= InlineWords;
+            if (index >= m_overflow.size()) {
+                m_overflow.resize(index + 1);
+            }
+            return m_overflow[index];
+        }
+
+    public:
+        bool contains(size_t id) const {
+            const word_type *word = find_word(id);
+            return word && (*word & to_bit(id)) != 0;
+        }
+
+        // returns false if the id was already in the set
+        bool insert(size_t id) {
+            word_type &word = get_word(id);
+            if (word & to_bit(id)) {
+                return false;
+            }
+            word |= to_bit(id);
+            return true;
+        }
+
+        void erase(size_t id) {
+            if (contains(id)) {
+                get_word(id) &= ~to_bit(id);
+            }
+        }
+
+        bool empty() const {
+            return std::ranges::all_of(m_inline, [](word_type word) { return word == 0; })
+                && std::ranges::all_of(m_overflow, [](word_type word) { return word == 0; });
+        }
+
+        void clear() {
+            m_inline.fill(0);
+            m_overflow.clear();
+        }
+    };
+
+}
+
+#endif
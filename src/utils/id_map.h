@@ -200,6 +200,11 @@ namespace utils {
             else return cend();
         }
 
+        // to be called after swapping the ids of two values, moves them into the slots of their new ids
+        void swap_slots(T &lhs, T &rhs) {
+            std::swap(m_data[get_id(lhs) - 1], m_data[get_id(rhs) - 1]);
+        }
+
         void erase(iterator it) {
             m_first_available_id = std::min(get_id(*it), m_first_available_id);
             --m_size;
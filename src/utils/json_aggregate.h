@@ -4,6 +4,8 @@
 #include "json_serial.h"
 #include "remove_defaults.h"
 
+#include <tuple>
+
 #include <reflect>
 
 namespace json {
@@ -35,11 +37,23 @@ namespace json {
                 });
             }(std::make_index_sequence<reflect::size<T>()>());
         }
+
+        void write(string_writer &out, const T &value, const Context &ctx) const {
+            out.begin_object();
+            reflect::for_each<T>([&](auto I) {
+                out.key(reflect::member_name<I, T>());
+                write_unchecked(out, reflect::get<I>(value), ctx);
+            });
+            out.end_object();
+        }
     };
 
     template<aggregate T, typename Context> requires all_fields_serializable<T, Context>
     struct serializer<T, Context> : aggregate_serializer_unchecked<T, Context> {};
 
+    template<typename T> struct is_optional : std::false_type {};
+    template<typename T> struct is_optional<std::optional<T>> : std::true_type {};
+
     template<aggregate T, typename Context>
     struct aggregate_deserializer_unchecked {
         template<size_t I>
@@ -48,6 +62,8 @@ namespace json {
             using value_type = reflect::member_type<I, T>;
             if (auto it = value.find(name); it != value.end()) {
                 return deserialize_unchecked<value_type>(*it, ctx);
+            } else if constexpr (is_optional<value_type>::value) {
+                return std::nullopt;
             } else {
                 throw deserialize_error(std::format("Cannot deserialize {}: missing field {}", reflect::type_name<T>(), name));
             }
@@ -61,6 +77,44 @@ namespace json {
                 return T{ deserialize_field<Is>(value, ctx) ... };
             }(std::make_index_sequence<reflect::size<T>()>());
         }
+
+        template<size_t I>
+        bool read_field(string_reader &in, const Context &ctx, std::string_view key, std::optional<reflect::member_type<I, T>> &field) const {
+            if (key != reflect::member_name<I, T>()) {
+                return false;
+            }
+            field.emplace(read_unchecked<reflect::member_type<I, T>>(in, ctx));
+            return true;
+        }
+
+        template<size_t I>
+        reflect::member_type<I, T> take_field(std::optional<reflect::member_type<I, T>> &field) const {
+            using value_type = reflect::member_type<I, T>;
+            if (field) {
+                return std::move(*field);
+            } else if constexpr (is_optional<value_type>::value) {
+                return std::nullopt;
+            } else {
+                throw deserialize_error(std::format("Cannot deserialize {}: missing field {}", reflect::type_name<T>(), reflect::member_name<I, T>()));
+            }
+        }
+
+        // fields can come in any order, unknown keys are skipped
+        T read(string_reader &in, const Context &ctx) const {
+            if (in.peek() != string_reader::value_kind::object) {
+                throw deserialize_error(std::format("Cannot deserialize {}: value is not an object", reflect::type_name<T>()));
+            }
+            return [&]<size_t ... Is>(std::index_sequence<Is ...>) {
+                std::tuple<std::optional<reflect::member_type<Is, T>> ...> fields;
+                in.begin_object();
+                while (auto key = in.next_key()) {
+                    if (!(read_field<Is>(in, ctx, *key, std::get<Is>(fields)) || ...)) {
+                        in.skip_value();
+                    }
+                }
+                return T{ take_field<Is>(std::get<Is>(fields)) ... };
+            }(std::make_index_sequence<reflect::size<T>()>());
+        }
     };
     
     template<aggregate T, typename Context> requires all_fields_deserializable<T, Context>
@@ -85,6 +139,27 @@ namespace json {
             });
             return result;
         }
+
+        void write(string_writer &out, const utils::remove_defaults<T> &value, const Context &ctx) const {
+            bool empty = true;
+            reflect::for_each<T>([&](auto I) {
+                const auto &member_value = reflect::get<I>(value.get());
+                using member_type = reflect::member_type<I, T>;
+                if (member_value != member_type{}) {
+                    if (empty) {
+                        out.begin_object();
+                        empty = false;
+                    }
+                    out.key(reflect::member_name<I, T>());
+                    write_unchecked(out, member_value, ctx);
+                }
+            });
+            if (empty) {
+                out.write_null();
+            } else {
+                out.end_object();
+            }
+        }
     };
 
     template<typename T, typename Context> requires all_fields_deserializable<T, Context>
@@ -98,6 +173,15 @@ namespace json {
                 return value_type{aggregate_deserializer_unchecked<T, Context>{*this}(value)};
             }
         }
+
+        value_type read(string_reader &in, const Context &ctx) const {
+            if (in.is_null()) {
+                in.read_null();
+                return value_type{};
+            } else {
+                return value_type{aggregate_deserializer_unchecked<T, Context>{}.read(in, ctx)};
+            }
+        }
     };
 
 }
@@ -5,6 +5,12 @@
 
 #include <vector>
 #include <chrono>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
 
 #include "range_utils.h"
 
@@ -39,6 +45,518 @@ namespace json {
 
     struct no_context {};
 
+    // appends json text straight into a string, without building a json tree first.
+    // non ascii characters are escaped and invalid utf8 is replaced, same as json::dump(-1, ' ', true, replace)
+    class string_writer {
+    public:
+        explicit string_writer(std::string &out)
+            : m_out{out}, m_begin{out.size()} {}
+
+        void begin_object() {
+            separate();
+            m_out.push_back('{');
+        }
+
+        void end_object() {
+            m_out.push_back('}');
+        }
+
+        void begin_array() {
+            separate();
+            m_out.push_back('[');
+        }
+
+        void end_array() {
+            m_out.push_back(']');
+        }
+
+        void key(std::string_view name) {
+            write_string(name);
+            m_out.push_back(':');
+        }
+
+        void write_null() {
+            separate();
+            m_out.append("null");
+        }
+
+        void write_bool(bool value) {
+            separate();
+            m_out.append(value ? "true" : "false");
+        }
+
+        template<typename T> requires std::is_arithmetic_v<T>
+        void write_number(T value) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (!std::isfinite(value)) {
+                    write_null();
+                    return;
+                }
+            }
+            separate();
+            char buffer[64];
+            if constexpr (std::is_floating_point_v<T>) {
+                // json stores every float as a double, and dump formats it with its own grisu2 to_chars
+                // which differs from std::to_chars: integral values keep a ".0" and exponents have two digits
+                char *end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(value));
+                m_out.append(buffer, end);
+            } else {
+                auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                m_out.append(buffer, end);
+            }
+        }
+
+        void write_string(std::string_view str) {
+            separate();
+            m_out.push_back('"');
+            for (size_t i=0; i<str.size();) {
+                auto c = static_cast<unsigned char>(str[i]);
+                if (c < 0x80) {
+                    switch (c) {
+                    case '"':  m_out.append("\\\""); break;
+                    case '\\': m_out.append("\\\\"); break;
+                    case '\b': m_out.append("\\b"); break;
+                    case '\f': m_out.append("\\f"); break;
+                    case '\n': m_out.append("\\n"); break;
+                    case '\r': m_out.append("\\r"); break;
+                    case '\t': m_out.append("\\t"); break;
+                    default:
+                        if (c < 0x20 || c == 0x7f) {
+                            write_codepoint_escape(c);
+                        } else {
+                            m_out.push_back(static_cast<char>(c));
+                        }
+                    }
+                    ++i;
+                } else {
+                    auto [codepoint, length] = decode_utf8(str.substr(i));
+                    if (codepoint >= 0x10000) {
+                        codepoint -= 0x10000;
+                        write_codepoint_escape(0xd800 + (codepoint >> 10));
+                        write_codepoint_escape(0xdc00 + (codepoint & 0x3ff));
+                    } else {
+                        write_codepoint_escape(codepoint);
+                    }
+                    i += length;
+                }
+            }
+            m_out.push_back('"');
+        }
+
+        // for values that are already serialized as json text
+        void write_raw(std::string_view value) {
+            separate();
+            m_out.append(value);
+        }
+
+        void write_json(const json &value) {
+            separate();
+            nlohmann::detail::serializer<json> serializer{nlohmann::detail::output_adapter<char>(m_out), ' ', json::error_handler_t::replace};
+            serializer.dump(value, false, true, 0);
+        }
+
+    private:
+        std::string &m_out;
+        size_t m_begin;
+
+        // every value but the first of an array or an object needs a comma before it
+        void separate() {
+            if (m_out.size() > m_begin) {
+                char last = m_out.back();
+                if (last != '[' && last != '{' && last != ':') {
+                    m_out.push_back(',');
+                }
+            }
+        }
+
+        void write_codepoint_escape(uint32_t codepoint) {
+            static constexpr char hex_digits[] = "0123456789abcdef";
+            char buffer[] = { '\\', 'u',
+                hex_digits[(codepoint >> 12) & 0xf],
+                hex_digits[(codepoint >> 8) & 0xf],
+                hex_digits[(codepoint >> 4) & 0xf],
+                hex_digits[codepoint & 0xf]
+            };
+            m_out.append(buffer, sizeof(buffer));
+        }
+
+        // returns U+FFFD for invalid sequences, consuming the bytes up to the first one that doesn't fit,
+        // which is read again as the start of the next sequence. this is how dump replaces invalid utf8
+        static std::pair<uint32_t, size_t> decode_utf8(std::string_view str) {
+            static constexpr std::pair<uint32_t, size_t> invalid{0xfffd, 1};
+
+            auto lead = static_cast<unsigned char>(str[0]);
+            size_t length;
+            uint32_t codepoint;
+            unsigned char min_next = 0x80, max_next = 0xbf;
+            if (lead >= 0xc2 && lead <= 0xdf) {
+                length = 2;
+                codepoint = lead & 0x1f;
+            } else if (lead >= 0xe0 && lead <= 0xef) {
+                length = 3;
+                codepoint = lead & 0x0f;
+                if (lead == 0xe0) min_next = 0xa0;
+                if (lead == 0xed) max_next = 0x9f;
+            } else if (lead >= 0xf0 && lead <= 0xf4) {
+                length = 4;
+                codepoint = lead & 0x07;
+                if (lead == 0xf0) min_next = 0x90;
+                if (lead == 0xf4) max_next = 0x8f;
+            } else {
+                return invalid;
+            }
+            for (size_t i=1; i<length; ++i) {
+                if (i == str.size()) {
+                    return {invalid.first, i};
+                }
+                auto c = static_cast<unsigned char>(str[i]);
+                if (c < min_next || c > max_next) {
+                    return {invalid.first, i};
+                }
+                min_next = 0x80;
+                max_next = 0xbf;
+                codepoint = (codepoint << 6) | (c & 0x3f);
+            }
+            return {codepoint, length};
+        }
+    };
+
+    // pulls values out of json text one token at a time, so that they can be deserialized without building a json tree.
+    // malformed input throws a deserialize_error as soon as it's found
+    class string_reader {
+    public:
+        static constexpr size_t default_max_depth = 32;
+
+        enum class value_kind { null, boolean, number, string, object, array };
+
+        explicit string_reader(std::string_view input, size_t max_depth = default_max_depth)
+            : m_input{input}, m_max_depth{max_depth} {}
+
+        value_kind peek() {
+            skip_whitespace();
+            if (m_pos == m_input.size()) {
+                fail("unexpected end of input");
+            }
+            switch (m_input[m_pos]) {
+            case 'n': return value_kind::null;
+            case 't':
+            case 'f': return value_kind::boolean;
+            case '"': return value_kind::string;
+            case '{': return value_kind::object;
+            case '[': return value_kind::array;
+            case '-':
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                return value_kind::number;
+            default:
+                fail("unexpected character");
+            }
+        }
+
+        bool is_null() {
+            return peek() == value_kind::null;
+        }
+
+        void read_null() {
+            skip_whitespace();
+            expect_literal("null");
+        }
+
+        bool read_bool() {
+            skip_whitespace();
+            if (m_input.substr(m_pos).starts_with("true")) {
+                m_pos += 4;
+                return true;
+            }
+            expect_literal("false");
+            return false;
+        }
+
+        template<typename T> requires std::is_arithmetic_v<T>
+        T read_number() {
+            std::string_view text = number_span();
+            T result{};
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), result);
+            if (ec != std::errc{} || end != text.data() + text.size()) {
+                fail(std::is_integral_v<T> ? "invalid integer" : "invalid number");
+            }
+            return result;
+        }
+
+        // the returned view is only valid until the next call on this reader
+        std::string_view read_string_view() {
+            skip_whitespace();
+            expect('"');
+            size_t begin = m_pos;
+            while (m_pos < m_input.size()) {
+                char c = m_input[m_pos];
+                if (c == '"') {
+                    return m_input.substr(begin, m_pos++ - begin);
+                } else if (c == '\\') {
+                    m_buffer.assign(m_input.substr(begin, m_pos - begin));
+                    return read_escaped_string();
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    fail("control character in string");
+                }
+                ++m_pos;
+            }
+            fail("unterminated string");
+        }
+
+        std::string read_string() {
+            return std::string(read_string_view());
+        }
+
+        void begin_object() {
+            enter('{');
+        }
+
+        // returns the next key of the current object, or nothing after consuming the closing brace.
+        // the returned view is only valid until the next call on this reader
+        std::optional<std::string_view> next_key() {
+            skip_whitespace();
+            if (m_pos < m_input.size() && m_input[m_pos] == '}') {
+                leave();
+                return std::nullopt;
+            }
+            separate();
+            std::string_view key = read_string_view();
+            skip_whitespace();
+            expect(':');
+            return key;
+        }
+
+        void begin_array() {
+            enter('[');
+        }
+
+        // returns false after consuming the closing bracket of the current array
+        bool next_element() {
+            skip_whitespace();
+            if (m_pos < m_input.size() && m_input[m_pos] == ']') {
+                leave();
+                return false;
+            }
+            separate();
+            return true;
+        }
+
+        void skip_value() {
+            switch (peek()) {
+            case value_kind::null: read_null(); break;
+            case value_kind::boolean: read_bool(); break;
+            case value_kind::number: number_span(); break;
+            case value_kind::string: read_string_view(); break;
+            case value_kind::object:
+                begin_object();
+                while (next_key()) {
+                    skip_value();
+                }
+                break;
+            case value_kind::array:
+                begin_array();
+                while (next_element()) {
+                    skip_value();
+                }
+                break;
+            }
+        }
+
+        // validates the next value and returns its text
+        std::string_view read_raw() {
+            skip_whitespace();
+            size_t begin = m_pos;
+            skip_value();
+            return m_input.substr(begin, m_pos - begin);
+        }
+
+        json read_json() {
+            return json::parse(read_raw());
+        }
+
+        void finish() {
+            skip_whitespace();
+            if (m_pos != m_input.size()) {
+                fail("unexpected trailing characters");
+            }
+        }
+
+    private:
+        std::string_view m_input;
+        size_t m_pos = 0;
+        size_t m_depth = 0;
+        size_t m_max_depth;
+        bool m_first = false;
+        std::string m_buffer;
+
+        [[noreturn]] void fail(std::string_view message) const {
+            throw deserialize_error(std::format("Cannot parse json: {} at offset {}", message, m_pos));
+        }
+
+        void skip_whitespace() {
+            while (m_pos < m_input.size()) {
+                switch (m_input[m_pos]) {
+                case ' ': case '\t': case '\n': case '\r':
+                    ++m_pos;
+                    break;
+                default:
+                    return;
+                }
+            }
+        }
+
+        void expect(char c) {
+            if (m_pos == m_input.size() || m_input[m_pos] != c) {
+                fail(std::format("expected '{}'", c));
+            }
+            ++m_pos;
+        }
+
+        void expect_literal(std::string_view literal) {
+            if (!m_input.substr(m_pos).starts_with(literal)) {
+                fail("invalid literal");
+            }
+            m_pos += literal.size();
+        }
+
+        void enter(char c) {
+            skip_whitespace();
+            expect(c);
+            if (++m_depth > m_max_depth) {
+                fail("maximum depth exceeded");
+            }
+            m_first = true;
+        }
+
+        void leave() {
+            ++m_pos;
+            --m_depth;
+            m_first = false;
+        }
+
+        // a single flag is enough: once a nested value is over, its parent is never at its first element
+        void separate() {
+            if (m_first) {
+                m_first = false;
+            } else {
+                expect(',');
+                skip_whitespace();
+            }
+        }
+
+        void skip_digits() {
+            size_t begin = m_pos;
+            while (m_pos < m_input.size() && m_input[m_pos] >= '0' && m_input[m_pos] <= '9') {
+                ++m_pos;
+            }
+            if (m_pos == begin) {
+                fail("invalid number");
+            }
+        }
+
+        bool skip_char(char c) {
+            if (m_pos < m_input.size() && m_input[m_pos] == c) {
+                ++m_pos;
+                return true;
+            }
+            return false;
+        }
+
+        std::string_view number_span() {
+            skip_whitespace();
+            size_t begin = m_pos;
+            skip_char('-');
+            if (!skip_char('0')) {
+                skip_digits();
+            }
+            if (skip_char('.')) {
+                skip_digits();
+            }
+            if (skip_char('e') || skip_char('E')) {
+                if (!skip_char('+')) {
+                    skip_char('-');
+                }
+                skip_digits();
+            }
+            return m_input.substr(begin, m_pos - begin);
+        }
+
+        uint32_t read_hex4() {
+            uint32_t result = 0;
+            const char *begin = m_input.data() + m_pos;
+            const char *end = m_input.data() + std::min(m_pos + 4, m_input.size());
+            auto [ptr, ec] = std::from_chars(begin, end, result, 16);
+            if (ec != std::errc{} || ptr != begin + 4) {
+                fail("invalid unicode escape");
+            }
+            m_pos += 4;
+            return result;
+        }
+
+        void append_utf8(uint32_t codepoint) {
+            if (codepoint < 0x80) {
+                m_buffer.push_back(static_cast<char>(codepoint));
+            } else if (codepoint < 0x800) {
+                m_buffer.push_back(static_cast<char>(0xc0 | (codepoint >> 6)));
+                m_buffer.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+            } else if (codepoint < 0x10000) {
+                m_buffer.push_back(static_cast<char>(0xe0 | (codepoint >> 12)));
+                m_buffer.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f)));
+                m_buffer.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+            } else {
+                m_buffer.push_back(static_cast<char>(0xf0 | (codepoint >> 18)));
+                m_buffer.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f)));
+                m_buffer.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f)));
+                m_buffer.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+            }
+        }
+
+        // slow path of read_string_view, m_pos is on the first backslash
+        std::string_view read_escaped_string() {
+            while (m_pos < m_input.size()) {
+                char c = m_input[m_pos++];
+                if (c == '"') {
+                    return m_buffer;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    fail("control character in string");
+                } else if (c != '\\') {
+                    m_buffer.push_back(c);
+                } else if (m_pos == m_input.size()) {
+                    break;
+                } else {
+                    switch (m_input[m_pos++]) {
+                    case '"':  m_buffer.push_back('"'); break;
+                    case '\\': m_buffer.push_back('\\'); break;
+                    case '/':  m_buffer.push_back('/'); break;
+                    case 'b':  m_buffer.push_back('\b'); break;
+                    case 'f':  m_buffer.push_back('\f'); break;
+                    case 'n':  m_buffer.push_back('\n'); break;
+                    case 'r':  m_buffer.push_back('\r'); break;
+                    case 't':  m_buffer.push_back('\t'); break;
+                    case 'u': {
+                        uint32_t codepoint = read_hex4();
+                        if (codepoint >= 0xd800 && codepoint <= 0xdbff) {
+                            expect_literal("\\u");
+                            uint32_t low = read_hex4();
+                            if (low < 0xdc00 || low > 0xdfff) {
+                                fail("invalid surrogate pair");
+                            }
+                            codepoint = 0x10000 + ((codepoint - 0xd800) << 10) + (low - 0xdc00);
+                        } else if (codepoint >= 0xdc00 && codepoint <= 0xdfff) {
+                            fail("invalid surrogate pair");
+                        }
+                        append_utf8(codepoint);
+                        break;
+                    }
+                    default:
+                        fail("invalid escape sequence");
+                    }
+                }
+            }
+            fail("unterminated string");
+        }
+    };
+
     template<typename T, typename Context> requires serializable<T, Context>
     json serialize_unchecked(const T &value, const Context &context) {
         serializer<T, Context> obj{};
@@ -65,6 +583,74 @@ namespace json {
         return serialize(value, no_context{});
     }
 
+    // serializers can provide a write function to skip building a json tree,
+    // the ones that don't are serialized as usual and their tree is dumped
+    template<typename T, typename Context> requires serializable<T, Context>
+    void write_unchecked(string_writer &out, const T &value, const Context &context) {
+        serializer<T, Context> obj{};
+        if constexpr (requires { obj.write(out, value, context); }) {
+            obj.write(out, value, context);
+        } else if constexpr (requires { obj.write(out, value); }) {
+            obj.write(out, value);
+        } else {
+            out.write_json(serialize_unchecked(value, context));
+        }
+    }
+
+    template<typename T, typename Context> requires serializable<T, Context>
+    void write(std::string &out, const T &value, const Context &context) {
+        string_writer writer{out};
+        try {
+            write_unchecked(writer, value, context);
+        } catch (const serialize_error &) {
+            throw;
+        } catch (const std::exception &e) {
+            throw serialize_error(e.what());
+        }
+    }
+
+    template<typename T> requires serializable<T, no_context>
+    void write(std::string &out, const T &value) {
+        write(out, value, no_context{});
+    }
+
+    // same as write_unchecked: deserializers without a read function get a json tree of their value
+    template<typename T, typename Context> requires deserializable<T, Context>
+    T read_unchecked(string_reader &in, const Context &context) {
+        deserializer<T, Context> obj{};
+        if constexpr (requires { obj.read(in, context); }) {
+            return obj.read(in, context);
+        } else if constexpr (requires { obj.read(in); }) {
+            return obj.read(in);
+        } else {
+            return deserialize_unchecked<T>(in.read_json(), context);
+        }
+    }
+
+    template<typename T, typename Context> requires deserializable<T, Context>
+    T read(std::string_view input, const Context &context) {
+        string_reader in{input};
+        try {
+            T result = read_unchecked<T>(in, context);
+            in.finish();
+            return result;
+        } catch (const json_error &) {
+            throw;
+        } catch (const std::exception &e) {
+            throw deserialize_error(e.what());
+        }
+    }
+
+    template<typename T> requires deserializable<T, no_context>
+    T read(std::string_view input) {
+        return read<T>(input, no_context{});
+    }
+
+    // a json value kept as text, to be deserialized later by whoever knows its context
+    struct raw_json {
+        std::string value;
+    };
+
     template<typename T, typename Context> requires deserializable<T, Context>
     auto deserialize_unchecked(const json &value, const Context &context) {
         deserializer<T, Context> obj{};
@@ -98,6 +684,18 @@ namespace json {
         json operator()(const T &value) const {
             return value;
         }
+
+        void write(string_writer &out, const T &value) const {
+            if constexpr (std::is_same_v<T, bool>) {
+                out.write_bool(value);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                out.write_number(value);
+            } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+                out.write_string(value);
+            } else {
+                out.write_json(value);
+            }
+        }
     };
 
     template<rn::range Range, typename Context> requires (
@@ -115,6 +713,14 @@ namespace json {
             }
             return ret;
         }
+
+        void write(string_writer &out, const Range &value, const Context &ctx) const {
+            out.begin_array();
+            for (const auto &obj : value) {
+                write_unchecked(out, obj, ctx);
+            }
+            out.end_array();
+        }
     };
 
     template<typename Rep, typename Period, typename Context>
@@ -122,6 +728,10 @@ namespace json {
         json operator()(const std::chrono::duration<Rep, Period> &value) const {
             return value.count();
         }
+
+        void write(string_writer &out, const std::chrono::duration<Rep, Period> &value) const {
+            out.write_number(value.count());
+        }
     };
 
     template<typename Clock, typename Duration, typename Context>
@@ -129,6 +739,10 @@ namespace json {
         json operator()(const std::chrono::time_point<Clock, Duration> &value, const Context &ctx) const {
             return serialize_unchecked(value.time_since_epoch(), ctx);
         }
+
+        void write(string_writer &out, const std::chrono::time_point<Clock, Duration> &value, const Context &ctx) const {
+            write_unchecked(out, value.time_since_epoch(), ctx);
+        }
     };
 
     template<typename T, typename Context> requires serializable<T, Context>
@@ -140,6 +754,14 @@ namespace json {
                 return json{};
             }
         }
+
+        void write(string_writer &out, const std::optional<T> &value, const Context &ctx) const {
+            if (value) {
+                write_unchecked(out, *value, ctx);
+            } else {
+                out.write_null();
+            }
+        }
     };
 
     template<typename First, typename Second, typename Context>
@@ -151,6 +773,13 @@ namespace json {
                 serialize_unchecked(value.second, ctx)
             });
         }
+
+        void write(string_writer &out, const std::pair<First, Second> &value, const Context &ctx) const {
+            out.begin_array();
+            write_unchecked(out, value.first, ctx);
+            write_unchecked(out, value.second, ctx);
+            out.end_array();
+        }
     };
     
     template<typename Context>
@@ -158,6 +787,32 @@ namespace json {
         json operator()(const json &value) const {
             return value;
         }
+
+        json read(string_reader &in) const {
+            return in.read_json();
+        }
+    };
+
+    template<typename Context>
+    struct serializer<raw_json, Context> {
+        json operator()(const raw_json &value) const {
+            return json::parse(value.value);
+        }
+
+        void write(string_writer &out, const raw_json &value) const {
+            out.write_raw(value.value);
+        }
+    };
+
+    template<typename Context>
+    struct deserializer<raw_json, Context> {
+        raw_json operator()(const json &value) const {
+            return { value.dump() };
+        }
+
+        raw_json read(string_reader &in) const {
+            return { std::string(in.read_raw()) };
+        }
     };
 
     template<typename T, typename Context> requires std::is_arithmetic_v<T>
@@ -178,6 +833,14 @@ namespace json {
             }
             return value.get<T>();
         }
+
+        T read(string_reader &in) const {
+            if constexpr (std::is_same_v<T, bool>) {
+                return in.read_bool();
+            } else {
+                return in.read_number<T>();
+            }
+        }
     };
 
     template<typename Context>
@@ -188,6 +851,10 @@ namespace json {
             }
             return value.get<std::string>();
         }
+
+        std::string read(string_reader &in) const {
+            return in.read_string();
+        }
     };
     
     template<rn::range Range, typename Context> requires (
@@ -204,6 +871,23 @@ namespace json {
                 })
                 | rn::to<Range>;
         }
+
+        Range read(string_reader &in, const Context &ctx) const {
+            using value_type = rn::range_value_t<Range>;
+            if (in.peek() != string_reader::value_kind::array) {
+                throw deserialize_error("Cannot deserialize range");
+            }
+            std::vector<value_type> values;
+            in.begin_array();
+            while (in.next_element()) {
+                values.push_back(read_unchecked<value_type>(in, ctx));
+            }
+            if constexpr (std::is_same_v<Range, std::vector<value_type>>) {
+                return values;
+            } else {
+                return values | rv::move | rn::to<Range>;
+            }
+        }
     };
 
     template<typename Rep, typename Period, typename Context>
@@ -214,6 +898,10 @@ namespace json {
             }
             return std::chrono::duration<Rep, Period>{value.get<Rep>()};
         }
+
+        std::chrono::duration<Rep, Period> read(string_reader &in) const {
+            return std::chrono::duration<Rep, Period>{in.read_number<Rep>()};
+        }
     };
     
     template<typename Clock, typename Duration, typename Context>
@@ -221,6 +909,10 @@ namespace json {
         std::chrono::time_point<Clock, Duration> operator()(const json &value, const Context &ctx) const {
             return std::chrono::time_point<Clock, Duration>{ deserialize_unchecked<Duration>(value, ctx) };
         }
+
+        std::chrono::time_point<Clock, Duration> read(string_reader &in, const Context &ctx) const {
+            return std::chrono::time_point<Clock, Duration>{ read_unchecked<Duration>(in, ctx) };
+        }
     };
 
     template<typename T, typename Context> requires deserializable<T, Context>
@@ -232,6 +924,15 @@ namespace json {
                 return deserialize_unchecked<T>(value, ctx);
             }
         }
+
+        std::optional<T> read(string_reader &in, const Context &ctx) const {
+            if (in.is_null()) {
+                in.read_null();
+                return std::nullopt;
+            } else {
+                return read_unchecked<T>(in, ctx);
+            }
+        }
     };
 
     template<typename First, typename Second, typename Context>
@@ -246,6 +947,26 @@ namespace json {
                 deserialize_unchecked<Second>(value[1], ctx)
             };
         }
+
+        std::pair<First, Second> read(string_reader &in, const Context &ctx) const {
+            static constexpr auto error_message = "Cannot deserialize pair: value is not an array of two elements";
+            if (in.peek() != string_reader::value_kind::array) {
+                throw deserialize_error(error_message);
+            }
+            in.begin_array();
+            if (!in.next_element()) {
+                throw deserialize_error(error_message);
+            }
+            First first = read_unchecked<First>(in, ctx);
+            if (!in.next_element()) {
+                throw deserialize_error(error_message);
+            }
+            Second second = read_unchecked<Second>(in, ctx);
+            if (in.next_element()) {
+                throw deserialize_error(error_message);
+            }
+            return { std::move(first), std::move(second) };
+        }
     };
 }
 
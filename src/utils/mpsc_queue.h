@@ -0,0 +1,128 @@
+#ifndef __MPSC_QUEUE_H__
+#define __MPSC_QUEUE_H__
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+
+namespace utils {
+
+    // bounded lock-free multi-producer single-consumer ring buffer.
+    // every cell carries a sequence number telling whether it is free for the producer
+    // at a given position or ready for the consumer, so producers only contend on a single CAS
+    template<typename T>
+    class mpsc_queue {
+    private:
+        static constexpr size_t cache_line_size = 64;
+
+        struct cell {
+            std::atomic<size_t> sequence;
+            alignas(T) std::byte storage[sizeof(T)];
+
+            T *get() {
+                return std::launder(reinterpret_cast<T *>(storage));
+            }
+        };
+
+        std::unique_ptr<cell[]> m_buffer;
+        size_t m_mask;
+
+        alignas(cache_line_size) std::atomic<size_t> m_enqueue_pos = 0;
+        alignas(cache_line_size) size_t m_dequeue_pos = 0;
+
+    public:
+        explicit mpsc_queue(size_t capacity)
+            : m_buffer{std::make_unique<cell[]>(capacity)}
+            , m_mask{capacity - 1}
+        {
+            if (capacity < 2 || (capacity & m_mask) != 0) {
+                throw std::invalid_argument("mpsc_queue capacity must be a power of two");
+            }
+            for (size_t i=0; i<capacity; ++i) {
+                m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        mpsc_queue(const mpsc_queue &) = delete;
+        mpsc_queue &operator = (const mpsc_queue &) = delete;
+
+        ~mpsc_queue() {
+            drain([](T &&) {});
+        }
+
+        size_t capacity() const {
+            return m_mask + 1;
+        }
+
+        // safe to call from any thread, returns false if the queue is full and leaves value untouched.
+        // with a reserve, it also fails unless that many cells are still free after this one, so they're kept
+        // for values that can't be dropped. concurrent producers may each take the last cells before the reserve
+        bool try_push(T &&value, size_t reserve = 0) {
+            static_assert(std::is_nothrow_move_constructible_v<T>);
+
+            if (reserve > m_mask) {
+                return false;
+            }
+
+            size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            cell *target;
+            while (true) {
+                target = &m_buffer[pos & m_mask];
+                size_t sequence = target->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    // cells are freed in order, so if the last reserved one is free all of them are
+                    if (reserve != 0) {
+                        const cell &last = m_buffer[(pos + reserve) & m_mask];
+                        size_t last_sequence = last.sequence.load(std::memory_order_acquire);
+                        if (static_cast<std::ptrdiff_t>(last_sequence) - static_cast<std::ptrdiff_t>(pos + reserve) < 0) {
+                            return false;
+                        }
+                    }
+                    if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            std::construct_at(target->get(), std::move(value));
+            target->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer thread only
+        std::optional<T> pop() {
+            cell &source = m_buffer[m_dequeue_pos & m_mask];
+            if (source.sequence.load(std::memory_order_acquire) != m_dequeue_pos + 1) {
+                return std::nullopt;
+            }
+            std::optional<T> result{std::move(*source.get())};
+            std::destroy_at(source.get());
+            source.sequence.store(m_dequeue_pos + m_mask + 1, std::memory_order_release);
+            ++m_dequeue_pos;
+            return result;
+        }
+
+        // consumer thread only.
+        // pops at most one full ring worth of elements, so producers can't keep the consumer here forever
+        template<typename Function>
+        size_t drain(Function &&fun) {
+            size_t count = 0;
+            for (; count <= m_mask; ++count) {
+                auto value = pop();
+                if (!value) break;
+                std::invoke(fun, std::move(*value));
+            }
+            return count;
+        }
+    };
+
+}
+
+#endif
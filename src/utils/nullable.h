@@ -44,6 +44,14 @@ namespace json {
                 return json{};
             }
         }
+
+        void write(string_writer &out, const utils::nullable<T> &value, const Context &ctx) const {
+            if (value) {
+                write_unchecked(out, value.get(), ctx);
+            } else {
+                out.write_null();
+            }
+        }
     };
 
     template<typename T, typename Context> requires deserializable<T, Context>
@@ -55,6 +63,15 @@ namespace json {
                 return deserialize_unchecked<T>(value, ctx);
             }
         }
+
+        utils::nullable<T> read(string_reader &in, const Context &ctx) const {
+            if (in.is_null()) {
+                in.read_null();
+                return {};
+            } else {
+                return read_unchecked<T>(in, ctx);
+            }
+        }
     };
 }
 
@@ -113,6 +113,14 @@ namespace json {
             }
             return ret;
         }
+
+        void write(string_writer &out, small_int_set value) const {
+            out.begin_array();
+            for (int n : value) {
+                out.write_number(n);
+            }
+            out.end_array();
+        }
     };
 }
 
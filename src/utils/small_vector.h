@@ -0,0 +1,87 @@
+#ifndef __SMALL_VECTOR_H__
+#define __SMALL_VECTOR_H__
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+namespace utils {
+
+    // vector of trivially copyable values that keeps up to N of them in place.
+    // past that every value is moved to the heap, so copying a small one never allocates
+    template<typename T, size_t N>
+    class small_vector {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+    private:
+        std::array<T, N> m_inline{};
+        std::vector<T> m_heap;
+        size_t m_size = 0;
+
+        bool is_inline() const {
+            return m_size <= N;
+        }
+
+    public:
+        using value_type = T;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        small_vector() = default;
+
+        small_vector(std::initializer_list<T> values) {
+            for (const T &value : values) {
+                push_back(value);
+            }
+        }
+
+        T *data() { return is_inline() ? m_inline.data() : m_heap.data(); }
+        const T *data() const { return is_inline() ? m_inline.data() : m_heap.data(); }
+
+        iterator begin() { return data(); }
+        iterator end() { return data() + m_size; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + m_size; }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        T &operator[](size_t index) { return data()[index]; }
+        const T &operator[](size_t index) const { return data()[index]; }
+
+        T &back() { return data()[m_size - 1]; }
+        const T &back() const { return data()[m_size - 1]; }
+
+        void push_back(const T &value) {
+            if (m_size < N) {
+                m_inline[m_size] = value;
+            } else {
+                if (m_size == N) {
+                    m_heap.assign(m_inline.begin(), m_inline.end());
+                }
+                m_heap.push_back(value);
+            }
+            ++m_size;
+        }
+
+        void pop_back() {
+            --m_size;
+            if (m_size == N) {
+                std::copy(m_heap.begin(), m_heap.begin() + N, m_inline.begin());
+                m_heap.clear();
+            } else if (m_size > N) {
+                m_heap.pop_back();
+            }
+        }
+
+        void clear() {
+            m_heap.clear();
+            m_size = 0;
+        }
+    };
+
+}
+
+#endif
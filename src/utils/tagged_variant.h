@@ -216,6 +216,10 @@ namespace json {
         json operator()(const utils::tagged_variant_index<utils::tagged_variant<Ts ...>> &value) const {
             return value.to_string();
         }
+
+        void write(string_writer &out, const utils::tagged_variant_index<utils::tagged_variant<Ts ...>> &value) const {
+            out.write_string(value.to_string());
+        }
     };
 
     template<typename Context, typename ... Ts>
@@ -227,6 +231,13 @@ namespace json {
             }
             return value_type{std::string_view(value.get<std::string>())};
         }
+
+        value_type read(string_reader &in) const {
+            if (in.peek() != string_reader::value_kind::string) {
+                throw deserialize_error("Cannot deserialize tagged variant index: value is not a string");
+            }
+            return value_type{in.read_string_view()};
+        }
     };
 
     template<typename T, typename Context>
@@ -253,6 +264,20 @@ namespace json {
                 }};
             }, value);
         }
+
+        void write(string_writer &out, const variant_type &value, const Context &ctx) const {
+            utils::visit_tagged([&](utils::tag_for<variant_type> auto tag, const auto & ... args) {
+                out.begin_object();
+                out.key(std::string_view{tag.name});
+                if constexpr (sizeof...(args) == 0) {
+                    out.begin_object();
+                    out.end_object();
+                } else {
+                    (write_unchecked(out, args, ctx), ...);
+                }
+                out.end_object();
+            }, value);
+        }
     };
 
     template<typename T, typename Context>
@@ -282,6 +307,31 @@ namespace json {
                 }
             }, index);
         }
+
+        variant_type read(string_reader &in, const Context &ctx) const {
+            if (in.peek() != string_reader::value_kind::object) {
+                throw deserialize_error("Cannot deserialize tagged variant: value is not an object");
+            }
+            in.begin_object();
+            auto key = in.next_key();
+            if (!key) {
+                throw deserialize_error("Cannot deserialize tagged variant: object must contain only one key");
+            }
+            utils::tagged_variant_index<variant_type> index{*key};
+            variant_type result = utils::visit_tagged([&](utils::tag_for<variant_type> auto tag) {
+                using value_type = utils::tagged_variant_value_type<variant_type, decltype(tag)>;
+                if constexpr (std::is_void_v<value_type>) {
+                    in.skip_value();
+                    return variant_type{tag};
+                } else {
+                    return variant_type{tag, read_unchecked<value_type>(in, ctx)};
+                }
+            }, index);
+            if (in.next_key()) {
+                throw deserialize_error("Cannot deserialize tagged variant: object must contain only one key");
+            }
+            return result;
+        }
     };
 }
 
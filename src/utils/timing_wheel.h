@@ -0,0 +1,146 @@
+#ifndef __TIMING_WHEEL_H__
+#define __TIMING_WHEEL_H__
+
+#include <array>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <concepts>
+#include <algorithm>
+#include <utility>
+
+namespace utils {
+
+    // hierarchical timing wheel: every timer is bucketed by its expiry, so advancing time only visits
+    // the timers that expire, plus a bucket of the next level being cascaded down every slot_count ticks.
+    // timers cannot be cancelled, whoever handles them is expected to check whether they are still relevant
+    template<typename T, size_t SlotBits = 6, size_t Levels = 4>
+    class timing_wheel {
+    public:
+        using tick_type = uint64_t;
+
+        static constexpr size_t slot_count = size_t{1} << SlotBits;
+        static constexpr tick_type slot_mask = slot_count - 1;
+        static constexpr tick_type max_delay = tick_type{1} << (SlotBits * Levels);
+
+    private:
+        struct entry {
+            tick_type expiry;
+            T value;
+        };
+
+        using slot = std::vector<entry>;
+
+        std::array<std::array<slot, slot_count>, Levels> m_slots;
+        tick_type m_now = 0;
+        size_t m_size = 0;
+
+        static constexpr size_t level_shift(size_t level) {
+            return SlotBits * level;
+        }
+
+        void insert(entry &&value) {
+            // distance from the next tick to be processed, clamped so that far timers stay in the last level and get cascaded again
+            tick_type next = m_now + 1;
+            tick_type distance = std::min(value.expiry - next, max_delay - 1);
+            size_t level = 0;
+            while (distance >= tick_type{1} << level_shift(level + 1)) {
+                ++level;
+            }
+            size_t index = ((next + distance) >> level_shift(level)) & slot_mask;
+            m_slots[level][index].push_back(std::move(value));
+        }
+
+        // moves the timers of a bucket one level down, returns its index
+        size_t cascade(size_t level, tick_type next) {
+            size_t index = (next >> level_shift(level)) & slot_mask;
+            slot entries = std::exchange(m_slots[level][index], {});
+            for (entry &value : entries) {
+                insert(std::move(value));
+            }
+            return index;
+        }
+
+    public:
+        tick_type now() const {
+            return m_now;
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        // the timer expires after delay ticks, at least one
+        void schedule(tick_type delay, T value) {
+            insert({ m_now + std::max<tick_type>(delay, 1), std::move(value) });
+            ++m_size;
+        }
+
+        // moves time forward, calling fn with the value of every timer that expires in order of expiry.
+        // fn is allowed to schedule new timers
+        template<std::invocable<T &&> Function>
+        void advance(tick_type elapsed, Function &&fn) {
+            for (; elapsed != 0; --elapsed) {
+                if (m_size == 0) {
+                    m_now += elapsed;
+                    break;
+                }
+
+                tick_type next = m_now + 1;
+                size_t index = next & slot_mask;
+                if (index == 0) {
+                    for (size_t level = 1; level < Levels && cascade(level, next) == 0; ++level);
+                }
+                m_now = next;
+
+                slot expired = std::exchange(m_slots[0][index], {});
+                m_size -= expired.size();
+                for (entry &value : expired) {
+                    fn(std::move(value.value));
+                }
+            }
+        }
+
+        // number of ticks until advance() has anything to do: either a timer expires or a bucket is cascaded,
+        // so this is a lower bound of the next expiry. returns nothing if there are no timers.
+        // a bucket of a higher level can be cascaded before the first non empty bucket of level 0 expires,
+        // so every level is checked and the earliest of them is returned
+        std::optional<tick_type> next_expiry() const {
+            if (m_size == 0) {
+                return std::nullopt;
+            }
+
+            tick_type next = m_now + 1;
+            std::optional<tick_type> result;
+            for (tick_type i = 0; i < slot_count; ++i) {
+                if (!m_slots[0][(next + i) & slot_mask].empty()) {
+                    result = i + 1;
+                    break;
+                }
+            }
+
+            for (size_t level = 1; level < Levels; ++level) {
+                tick_type period = tick_type{1} << level_shift(level);
+                tick_type first = (next + period - 1) & ~(period - 1);
+                for (tick_type i = 0; i < slot_count; ++i) {
+                    tick_type time = first + i * period;
+                    if (result && time - m_now >= *result) {
+                        break;
+                    }
+                    if (!m_slots[level][(time >> level_shift(level)) & slot_mask].empty()) {
+                        result = time - m_now;
+                        break;
+                    }
+                }
+            }
+            return result;
+        }
+    };
+
+}
+
+#endif
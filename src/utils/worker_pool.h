@@ -0,0 +1,127 @@
+#ifndef __WORKER_POOL_H__
+#define __WORKER_POOL_H__
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "range_utils.h"
+
+namespace utils {
+
+    // a fixed set of worker threads, each owning its own task queue.
+    // work submitted with the same shard key always runs on the same thread, in submission order
+    class worker_pool {
+    private:
+        struct worker {
+            std::mutex mutex;
+            std::condition_variable_any cv;
+            std::vector<std::move_only_function<void()>> tasks;
+            std::jthread thread;
+        };
+
+        std::vector<std::unique_ptr<worker>> m_workers;
+
+        static void worker_loop(std::stop_token stop, worker &self) {
+            std::vector<std::move_only_function<void()>> tasks;
+            while (true) {
+                {
+                    std::unique_lock lock{self.mutex};
+                    if (!self.cv.wait(lock, stop, [&]{ return !self.tasks.empty(); })) {
+                        return;
+                    }
+                    std::swap(tasks, self.tasks);
+                }
+                for (auto &task : tasks) {
+                    task();
+                }
+                tasks.clear();
+            }
+        }
+
+    public:
+        worker_pool() = default;
+
+        explicit worker_pool(size_t num_workers) {
+            start(num_workers);
+        }
+
+        worker_pool(const worker_pool &) = delete;
+        worker_pool &operator = (const worker_pool &) = delete;
+
+        void start(size_t num_workers) {
+            m_workers.clear();
+            for (size_t i=0; i<num_workers; ++i) {
+                auto &self = *m_workers.emplace_back(std::make_unique<worker>());
+                self.thread = std::jthread(&worker_loop, std::ref(self));
+            }
+        }
+
+        size_t size() const {
+            return m_workers.size();
+        }
+
+        void submit(size_t shard, std::move_only_function<void()> task) {
+            worker &self = *m_workers[shard % m_workers.size()];
+            {
+                std::scoped_lock lock{self.mutex};
+                self.tasks.push_back(std::move(task));
+            }
+            self.cv.notify_one();
+        }
+
+        // calls fun on every element of range, distributing elements between workers by shard_key.
+        // blocks until all calls have returned. if fun throws, the rest of that shard is skipped
+        // and the first exception is rethrown here once every worker is done.
+        // with no workers started everything runs inline on the calling thread
+        template<rn::input_range Range, typename Function, typename Projection>
+        void for_each_sharded(Range &&range, Function &&fun, Projection &&shard_key) {
+            if (m_workers.empty()) {
+                for (auto &&value : range) {
+                    std::invoke(fun, value);
+                }
+                return;
+            }
+
+            using value_type = std::remove_reference_t<rn::range_reference_t<Range>>;
+            using shard_values = std::vector<value_type *>;
+
+            std::vector<shard_values> shards(m_workers.size());
+            for (auto &&value : range) {
+                shards[static_cast<size_t>(std::invoke(shard_key, value)) % shards.size()].push_back(std::addressof(value));
+            }
+
+            std::vector<std::exception_ptr> errors(shards.size());
+            std::latch done{static_cast<std::ptrdiff_t>(rn::count_if(shards, std::not_fn(&shard_values::empty)))};
+            for (size_t i=0; i<shards.size(); ++i) {
+                if (!shards[i].empty()) {
+                    submit(i, [&fun, &done, &values = shards[i], &error = errors[i]]{
+                        try {
+                            for (value_type *value : values) {
+                                std::invoke(fun, *value);
+                            }
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                        done.count_down();
+                    });
+                }
+            }
+            done.wait();
+
+            for (const std::exception_ptr &error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+    };
+
+}
+
+#endif